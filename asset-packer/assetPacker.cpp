@@ -0,0 +1,201 @@
+/*
+ * Asset Packer
+ * Builds the bitmap pack used by instrument-panel so it can start
+ * without inflating any PNGs.
+ *
+ * Every PNG in the bitmaps directory is decoded and stored as
+ * premultiplied RGBA in a single file (see bitmapPack.h). The panel maps
+ * the pack into memory and copies pixels straight into its bitmaps. Any
+ * PNG changed after the pack was built is loaded as normal, so the pack
+ * only needs rebuilding to get the speed back.
+ *
+ * Usage: asset-packer [bitmaps_dir]
+ *
+ *   bitmaps_dir .... Directory of PNGs (default instrument-panel/bitmaps).
+ *                    The pack is written to bitmaps_dir/bitmaps.pack
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_image.h>
+#include "bitmapPack.h"
+
+const int MaxEntries = 256;
+
+struct Source {
+    char path[512];
+    int64_t size;
+    int64_t mtime;
+};
+
+static bool isPng(const char* name)
+{
+    int len = strlen(name);
+    return len > 4 && (strcmp(name + len - 4, ".png") == 0 || strcmp(name + len - 4, ".PNG") == 0);
+}
+
+static const char* baseName(const char* path)
+{
+    const char* name = path;
+    for (const char* c = path; *c; c++) {
+        if (*c == '/' || *c == '\\') {
+            name = c + 1;
+        }
+    }
+    return name;
+}
+
+static uint64_t roundUp(uint64_t bytes, uint64_t align)
+{
+    return (bytes + align - 1) / align * align;
+}
+
+/// <summary>
+/// Finds every PNG in the directory. Returns the number found or -1 if
+/// the directory can't be read.
+/// </summary>
+static int findSources(const char* dir, Source* sources)
+{
+    ALLEGRO_FS_ENTRY* dirEntry = al_create_fs_entry(dir);
+    if (!dirEntry || !al_open_directory(dirEntry)) {
+        return -1;
+    }
+
+    int count = 0;
+    ALLEGRO_FS_ENTRY* entry;
+    while ((entry = al_read_directory(dirEntry)) != NULL) {
+        const char* path = al_get_fs_entry_name(entry);
+
+        if ((al_get_fs_entry_mode(entry) & ALLEGRO_FILEMODE_ISFILE) && isPng(path)) {
+            if (strlen(baseName(path)) >= (size_t)PackNameSize) {
+                printf("Skipping %s as the name is too long\n", path);
+            }
+            else if (count == MaxEntries) {
+                printf("Skipping %s as there are too many bitmaps\n", path);
+            }
+            else {
+                Source* source = &sources[count++];
+                strncpy(source->path, path, sizeof(source->path) - 1);
+                source->path[sizeof(source->path) - 1] = '\0';
+                source->size = al_get_fs_entry_size(entry);
+                source->mtime = al_get_fs_entry_mtime(entry);
+            }
+        }
+
+        al_destroy_fs_entry(entry);
+    }
+
+    al_close_directory(dirEntry);
+    al_destroy_fs_entry(dirEntry);
+    return count;
+}
+
+int main(int argc, char* argv[])
+{
+    char dir[256] = "instrument-panel/bitmaps";
+
+    if (argc > 2) {
+        printf("Usage: asset-packer [bitmaps_dir]\n");
+        return 1;
+    }
+    else if (argc == 2) {
+        strncpy(dir, argv[1], sizeof(dir) - 1);
+    }
+
+    int len = strlen(dir);
+    if (len > 0 && (dir[len - 1] == '/' || dir[len - 1] == '\\')) {
+        dir[len - 1] = '\0';
+    }
+
+    if (!al_init() || !al_init_image_addon()) {
+        printf("Failed to initialise Allegro\n");
+        return 1;
+    }
+
+    // No display so decode into memory (premultiplied by default)
+    al_set_new_bitmap_flags(ALLEGRO_MEMORY_BITMAP);
+
+    Source* sources = new Source[MaxEntries];
+    int count = findSources(dir, sources);
+    if (count < 0) {
+        printf("Failed to read directory %s\n", dir);
+        return 1;
+    }
+
+    char packPath[512];
+    sprintf(packPath, "%s/%s", dir, PackFile);
+
+    FILE* outfile = fopen(packPath, "wb");
+    if (!outfile) {
+        printf("Failed to create %s\n", packPath);
+        return 1;
+    }
+
+    // Entries are written last once the pixel offsets are known
+    PackHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = PackMagic;
+    header.version = PackVersion;
+
+    PackEntry* entries = new PackEntry[MaxEntries];
+    memset(entries, 0, sizeof(PackEntry) * MaxEntries);
+
+    uint64_t offset = roundUp(sizeof(PackHeader) + (uint64_t)count * sizeof(PackEntry), PackAlign);
+    long long totalBytes = 0;
+
+    for (int i = 0; i < count; i++) {
+        ALLEGRO_BITMAP* bitmap = al_load_bitmap(sources[i].path);
+        if (!bitmap) {
+            printf("Failed to decode %s\n", sources[i].path);
+            continue;
+        }
+
+        int width = al_get_bitmap_width(bitmap);
+        int height = al_get_bitmap_height(bitmap);
+        ALLEGRO_LOCKED_REGION* region = al_lock_bitmap(bitmap, ALLEGRO_PIXEL_FORMAT_ABGR_8888_LE, ALLEGRO_LOCK_READONLY);
+        if (!region) {
+            printf("Failed to lock %s\n", sources[i].path);
+            al_destroy_bitmap(bitmap);
+            continue;
+        }
+
+        PackEntry* entry = &entries[header.entryCount++];
+        strcpy(entry->name, baseName(sources[i].path));
+        entry->width = width;
+        entry->height = height;
+        entry->sourceSize = sources[i].size;
+        entry->sourceTime = sources[i].mtime;
+        entry->offset = offset;
+
+        fseek(outfile, (long)offset, SEEK_SET);
+        for (int y = 0; y < height; y++) {
+            fwrite((const char*)region->data + y * region->pitch, 4, width, outfile);
+        }
+
+        al_unlock_bitmap(bitmap);
+        al_destroy_bitmap(bitmap);
+
+        uint64_t bytes = (uint64_t)width * height * 4;
+        printf("%-32s %5d x %-5d %8lld KB\n", entry->name, width, height, (long long)bytes / 1024);
+        offset = roundUp(offset + bytes, PackAlign);
+        totalBytes += bytes;
+    }
+
+    fseek(outfile, 0, SEEK_SET);
+    fwrite(&header, sizeof(header), 1, outfile);
+    fwrite(entries, sizeof(PackEntry), header.entryCount, outfile);
+
+    bool failed = ferror(outfile) != 0;
+    if (fclose(outfile) != 0 || failed) {
+        printf("Failed to write %s\n", packPath);
+        remove(packPath);
+        return 1;
+    }
+
+    printf("Packed %d bitmaps (%lld KB) into %s\n", header.entryCount, totalBytes / 1024, packPath);
+
+    delete[] entries;
+    delete[] sources;
+    return 0;
+}
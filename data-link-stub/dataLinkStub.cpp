@@ -0,0 +1,922 @@
+/*
+ * Data Link Stub
+ * Stands in for instrument-data-link so instrument-panel can be run
+ * and measured without a flight simulator.
+ *
+ * Speaks the same UDP protocol as instrument-data-link. It answers
+ * polls, accepts write events and streams deltas to panels that
+ * subscribe. Panels that subscribe with a multicast group share a
+ * single stream, so the sender's cost stays the same however many
+ * panels join the group.
+ *
+ * Samples come from a synthetic flight or a recording at the requested
+ * rate. A recording is either a file of SimVars structs, one per sample,
+ * or a flight recording (.svr) made by the panel which is replayed with
+ * its recorded timing. Jitter and packet loss can be added to test how
+ * panels cope.
+ *
+ * Usage: data-link-stub [options]
+ *
+ *   -p port ........ Port to listen on (default 52020)
+ *   -r rate ........ Samples per second (default 50)
+ *   -f file ........ Replay a recording (loops) instead of synthetic data
+ *   -o file ........ Record the samples served to a file
+ *   -c host[:port] . Capture samples from a real instrument-data-link
+ *                    into the -o file instead of serving
+ *   -j ms .......... Delay each packet by a random 0 to ms
+ *   -l percent ..... Drop this percentage of packets
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+#include <signal.h>
+#include <chrono>
+#include <sys/socket.h>
+#include <sys/select.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include "simvarDelta.h"
+#include "flightRecorder.h"
+
+using namespace std::chrono;
+
+const int MaxSubscribers = 64;
+const int MaxDelayed = 1024;
+const int StatsIntervalSecs = 5;
+
+struct Subscriber {
+    bool inUse = false;
+    sockaddr_in addr;
+    int stream;
+    int rate;
+    uint32_t fields[MaxSimVarFields / 32];
+    steady_clock::time_point expires;
+};
+
+struct Stream {
+    bool inUse = false;
+    bool multicast;
+    sockaddr_in dest;
+    int rate;
+    int keyframeInterval;
+    uint32_t fields[MaxSimVarFields / 32];
+    SimVars prev;
+    uint32_t sequence;
+    int sinceKeyframe;
+    bool keyframePending;
+    steady_clock::time_point nextSend;
+};
+
+// Packets held back to simulate jitter
+struct DelayedPacket {
+    steady_clock::time_point due;
+    sockaddr_in dest;
+    int bytes;
+    char data[MaxDeltaSize];
+};
+
+// Same layout as the panel sends
+struct WriteRequest {
+    long bytes;
+    WriteData writeData;
+};
+
+Subscriber subscribers[MaxSubscribers];
+Stream streams[MaxSubscribers];
+DelayedPacket* delayed = NULL;
+int delayedCount = 0;
+
+int sampleRate = 50;
+int jitterMs = 0;
+double lossPercent = 0;
+
+// Recording being replayed (NULL for synthetic data)
+SimVars* recording = NULL;
+long recordingCount = 0;
+
+// Receive times (us) of a flight recording's samples
+int64_t* recordingTimes = NULL;
+
+volatile sig_atomic_t quit = 0;
+
+long long sentPackets = 0;
+long long sentBytes = 0;
+long long droppedPackets = 0;
+long long polls = 0;
+long long writes = 0;
+
+void stop(int signum)
+{
+    quit = 1;
+}
+
+/// <summary>
+/// Generates a gentle, repeating flight so every instrument moves.
+/// </summary>
+void synthesise(SimVars* simVars, double secs)
+{
+    simVars->connected = 1;
+    simVars->asiAirspeed = 110 + 30 * sin(secs / 20);
+    simVars->asiMachSpeed = simVars->asiAirspeed / 661.5;
+    simVars->altAltitude = 3000 + 1500 * sin(secs / 60);
+    simVars->vsiVerticalSpeed = 1500 * cos(secs / 60);
+    simVars->hiHeading = fmod(secs * 3, 360);
+    simVars->adiPitch = 5 * sin(secs / 7);
+    simVars->adiBank = 25 * sin(secs / 11);
+    simVars->tcRate = simVars->adiBank / 10;
+    simVars->tcBall = 0.2 * sin(secs / 3);
+    simVars->rpmEngine = 2300 + 100 * sin(secs / 13);
+    simVars->rpmPercent = simVars->rpmEngine / 27;
+    simVars->rpmElapsedTime = secs / 3600;
+    simVars->fuelLeft = 20 - fmod(secs / 120, 20);
+    simVars->fuelRight = simVars->fuelLeft;
+    simVars->oilTemp = 180 + 5 * sin(secs / 30);
+    simVars->oilPress = 60 + 3 * sin(secs / 17);
+    simVars->suctionPressure = 5;
+    simVars->exhaustGasTemp = 1300 + 50 * sin(secs / 9);
+    simVars->engineFuelFlow = 8;
+    simVars->dcFlightSeconds = secs;
+    simVars->dcUtcSeconds = fmod(43200 + secs, 86400);
+    simVars->dcLocalSeconds = fmod(46800 + secs, 86400);
+    simVars->vor1RadialError = 10 * sin(secs / 15);
+    simVars->vor1GlideSlopeError = 0.5 * sin(secs / 10);
+    simVars->vor1ToFrom = 1;
+    simVars->vor2RadialError = 10 * cos(secs / 15);
+    simVars->vor2ToFrom = 1;
+    simVars->adfRadial = fmod(secs * 5, 360);
+    simVars->parkingBrakeOn = 0;
+    simVars->gearRetractable = 0;
+    simVars->tfFlapsCount = 4;
+    strcpy(simVars->atcTailNumber, "G-STUB");
+    strcpy(simVars->aircraft, "Cessna 152 Asobo");
+}
+
+/// <summary>
+/// Gets the sample for the given time from the recording or the
+/// synthetic flight. Samples only change at the configured rate.
+/// </summary>
+void nextSample(SimVars* simVars, long sampleNum)
+{
+    if (recordingTimes) {
+        // Latest sample received by this point in the recording
+        int64_t duration = recordingTimes[recordingCount - 1] - recordingTimes[0] + 1;
+        int64_t elapsed = (int64_t)sampleNum * 1000000 / sampleRate % duration;
+        int64_t target = recordingTimes[0] + elapsed;
+
+        long low = 0;
+        long high = recordingCount - 1;
+        while (low < high) {
+            long mid = (low + high + 1) / 2;
+            if (recordingTimes[mid] <= target) {
+                low = mid;
+            }
+            else {
+                high = mid - 1;
+            }
+        }
+        *simVars = recording[low];
+    }
+    else if (recording) {
+        *simVars = recording[sampleNum % recordingCount];
+    }
+    else {
+        synthesise(simVars, (double)sampleNum / sampleRate);
+    }
+}
+
+/// <summary>
+/// Applies a write event from a panel. Only the synthetic flight can be
+/// changed, a recording always plays back as recorded.
+/// </summary>
+void applyEvent(SimVars* simVars, WriteData* writeData)
+{
+    double val = writeData->value;
+    double temp;
+
+    printf("Event %d value %g\n", writeData->eventId, val);
+    if (recording) {
+        return;
+    }
+
+    switch (writeData->eventId) {
+    case KEY_TRUE_AIRSPEED_CAL_SET:
+        simVars->asiAirspeedCal = val;
+        break;
+    case KEY_KOHLSMAN_SET:
+        simVars->altKollsman = val / 541.82224;
+        break;
+    case KEY_VOR1_SET:
+        simVars->vor1Obs = val;
+        break;
+    case KEY_VOR2_SET:
+        simVars->vor2Obs = val;
+        break;
+    case KEY_FLAPS_INCR:
+        if (simVars->tfFlapsIndex < simVars->tfFlapsCount) {
+            simVars->tfFlapsIndex++;
+        }
+        break;
+    case KEY_FLAPS_DECR:
+        if (simVars->tfFlapsIndex > 0) {
+            simVars->tfFlapsIndex--;
+        }
+        break;
+    case KEY_ADF_CARD_SET:
+        simVars->adfCard = val;
+        break;
+    case KEY_COM_STBY_RADIO_SET:
+        simVars->com1Standby = val;
+        break;
+    case KEY_COM_RADIO_SWAP:
+        temp = simVars->com1Freq;
+        simVars->com1Freq = simVars->com1Standby;
+        simVars->com1Standby = temp;
+        break;
+    case KEY_COM2_STBY_RADIO_SET:
+        simVars->com2Standby = val;
+        break;
+    case KEY_COM2_RADIO_SWAP:
+        temp = simVars->com2Freq;
+        simVars->com2Freq = simVars->com2Standby;
+        simVars->com2Standby = temp;
+        break;
+    case KEY_NAV1_STBY_SET:
+        simVars->nav1Standby = val;
+        break;
+    case KEY_NAV1_RADIO_SWAP:
+        temp = simVars->nav1Freq;
+        simVars->nav1Freq = simVars->nav1Standby;
+        simVars->nav1Standby = temp;
+        break;
+    case KEY_NAV2_STBY_SET:
+        simVars->nav2Standby = val;
+        break;
+    case KEY_NAV2_RADIO_SWAP:
+        temp = simVars->nav2Freq;
+        simVars->nav2Freq = simVars->nav2Standby;
+        simVars->nav2Standby = temp;
+        break;
+    case KEY_ADF_COMPLETE_SET:
+        simVars->adfStandby = val;
+        break;
+    case KEY_ADF1_PRIMARY_SET:
+        simVars->adfFreq = val;
+        break;
+    case KEY_XPNDR_SET:
+        simVars->transponderCode = val;
+        break;
+    case KEY_AP_MASTER:
+        simVars->autopilotEngaged = !simVars->autopilotEngaged;
+        break;
+    case KEY_AP_SPD_VAR_SET:
+        simVars->autopilotAirspeed = val;
+        break;
+    case KEY_AP_MACH_VAR_SET:
+        simVars->autopilotMach = val / 100;
+        break;
+    case KEY_HEADING_BUG_SET:
+        simVars->autopilotHeading = val;
+        break;
+    case KEY_AP_ALT_VAR_SET_ENGLISH:
+        simVars->autopilotAltitude = val;
+        break;
+    case KEY_AP_VS_VAR_SET_ENGLISH:
+        simVars->autopilotVerticalSpeed = val;
+        break;
+    case KEY_AP_AIRSPEED_ON:
+        simVars->autopilotAirspeedHold = 1;
+        break;
+    case KEY_AP_AIRSPEED_OFF:
+        simVars->autopilotAirspeedHold = 0;
+        break;
+    case KEY_AP_HDG_HOLD_ON:
+        simVars->autopilotHeadingLock = 1;
+        break;
+    case KEY_AP_HDG_HOLD_OFF:
+        simVars->autopilotHeadingLock = 0;
+        break;
+    case KEY_AP_ALT_HOLD_ON:
+        simVars->autopilotAltLock = 1;
+        break;
+    case KEY_AP_ALT_HOLD_OFF:
+        simVars->autopilotAltLock = 0;
+        break;
+    default:
+        break;
+    }
+}
+
+/// <summary>
+/// Sends a packet, or drops or delays it if loss or jitter is enabled.
+/// </summary>
+void sendPacket(int sockfd, const char* data, int bytes, sockaddr_in* dest, steady_clock::time_point now)
+{
+    if (lossPercent > 0 && rand() % 10000 < lossPercent * 100) {
+        droppedPackets++;
+        return;
+    }
+
+    if (jitterMs > 0 && delayedCount < MaxDelayed) {
+        DelayedPacket* packet = &delayed[delayedCount++];
+        packet->due = now + microseconds(rand() % (jitterMs * 1000));
+        packet->dest = *dest;
+        packet->bytes = bytes;
+        memcpy(packet->data, data, bytes);
+        return;
+    }
+
+    if (sendto(sockfd, data, bytes, 0, (sockaddr*)dest, sizeof(*dest)) == bytes) {
+        sentPackets++;
+        sentBytes += bytes;
+    }
+}
+
+/// <summary>
+/// Sends any delayed packets that are now due. Packets may go out in
+/// a different order to the one they were sent in, as on a real network.
+/// </summary>
+void sendDelayed(int sockfd, steady_clock::time_point now)
+{
+    int i = 0;
+    while (i < delayedCount) {
+        DelayedPacket* packet = &delayed[i];
+        if (packet->due > now) {
+            i++;
+            continue;
+        }
+
+        if (sendto(sockfd, packet->data, packet->bytes, 0, (sockaddr*)&packet->dest, sizeof(packet->dest)) == packet->bytes) {
+            sentPackets++;
+            sentBytes += packet->bytes;
+        }
+
+        delayedCount--;
+        if (i < delayedCount) {
+            *packet = delayed[delayedCount];
+        }
+    }
+}
+
+/// <summary>
+/// Recalculates a stream's rate and fields from its subscribers and
+/// releases the stream if nobody is subscribed to it any more.
+/// </summary>
+void updateStream(int streamNum)
+{
+    Stream* stream = &streams[streamNum];
+    bool inUse = false;
+
+    stream->rate = 0;
+    memset(stream->fields, 0, sizeof(stream->fields));
+
+    for (int i = 0; i < MaxSubscribers; i++) {
+        Subscriber* sub = &subscribers[i];
+        if (sub->inUse && sub->stream == streamNum) {
+            inUse = true;
+            if (sub->rate > stream->rate) {
+                stream->rate = sub->rate;
+            }
+            if (stream->rate > sampleRate) {
+                // No point sending faster than samples change
+                stream->rate = sampleRate;
+            }
+            for (int j = 0; j < MaxSimVarFields / 32; j++) {
+                stream->fields[j] |= sub->fields[j];
+            }
+        }
+    }
+
+    stream->inUse = inUse;
+}
+
+/// <summary>
+/// Finds the stream for a new subscription. Multicast subscribers to
+/// the same group share a stream, unicast subscribers get their own.
+/// </summary>
+int findStream(sockaddr_in* dest, bool multicast)
+{
+    if (multicast) {
+        for (int i = 0; i < MaxSubscribers; i++) {
+            if (streams[i].inUse && streams[i].multicast
+                && streams[i].dest.sin_addr.s_addr == dest->sin_addr.s_addr
+                && streams[i].dest.sin_port == dest->sin_port) {
+                return i;
+            }
+        }
+    }
+
+    for (int i = 0; i < MaxSubscribers; i++) {
+        if (!streams[i].inUse) {
+            Stream* stream = &streams[i];
+            stream->inUse = true;
+            stream->multicast = multicast;
+            stream->dest = *dest;
+            stream->sequence = 0;
+            stream->sinceKeyframe = 0;
+            stream->keyframePending = true;
+            stream->nextSend = steady_clock::now();
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/// <summary>
+/// Adds, renews or cancels (rate 0) a panel's subscription.
+/// </summary>
+void subscribe(SubscribeRequest* request, sockaddr_in* from)
+{
+    int subNum = -1;
+    for (int i = 0; i < MaxSubscribers; i++) {
+        if (subscribers[i].inUse && subscribers[i].addr.sin_addr.s_addr == from->sin_addr.s_addr
+            && subscribers[i].addr.sin_port == from->sin_port) {
+            subNum = i;
+            break;
+        }
+    }
+
+    if (request->rate <= 0) {
+        if (subNum != -1) {
+            subscribers[subNum].inUse = false;
+            updateStream(subscribers[subNum].stream);
+            printf("Unsubscribed %s:%d\n", inet_ntoa(from->sin_addr), ntohs(from->sin_port));
+        }
+        return;
+    }
+
+    sockaddr_in dest = *from;
+    bool multicast = request->multicastAddr != 0;
+    if (multicast) {
+        dest.sin_addr.s_addr = request->multicastAddr;
+        dest.sin_port = htons(request->multicastPort);
+    }
+
+    // Moved to a different destination so start again
+    if (subNum != -1) {
+        Stream* stream = &streams[subscribers[subNum].stream];
+        if (stream->multicast != multicast || stream->dest.sin_addr.s_addr != dest.sin_addr.s_addr
+            || stream->dest.sin_port != dest.sin_port) {
+            subscribers[subNum].inUse = false;
+            updateStream(subscribers[subNum].stream);
+            subNum = -1;
+        }
+    }
+
+    if (subNum == -1) {
+        for (int i = 0; i < MaxSubscribers; i++) {
+            if (!subscribers[i].inUse) {
+                subNum = i;
+                break;
+            }
+        }
+
+        int streamNum = subNum == -1 ? -1 : findStream(&dest, multicast);
+        if (streamNum == -1) {
+            printf("Too many subscribers, ignoring %s:%d\n", inet_ntoa(from->sin_addr), ntohs(from->sin_port));
+            return;
+        }
+
+        subscribers[subNum].inUse = true;
+        subscribers[subNum].addr = *from;
+        subscribers[subNum].stream = streamNum;
+        streams[streamNum].keyframePending = true;
+        char group[64] = "";
+        if (multicast) {
+            sprintf(group, " to multicast group %s:%d", inet_ntoa(dest.sin_addr), ntohs(dest.sin_port));
+        }
+        printf("Subscribed %s:%d at %d Hz%s\n", inet_ntoa(from->sin_addr), ntohs(from->sin_port), request->rate, group);
+    }
+
+    Subscriber* sub = &subscribers[subNum];
+    sub->rate = request->rate;
+    memcpy(sub->fields, request->fields, sizeof(sub->fields));
+    sub->expires = steady_clock::now() + milliseconds(request->leaseMs);
+
+    Stream* stream = &streams[sub->stream];
+    stream->keyframeInterval = request->keyframeInterval;
+    if (request->flags & SubscribeKeyframe) {
+        stream->keyframePending = true;
+    }
+
+    updateStream(sub->stream);
+}
+
+/// <summary>
+/// Drops subscribers that haven't renewed their lease.
+/// </summary>
+void expireSubscribers(steady_clock::time_point now)
+{
+    for (int i = 0; i < MaxSubscribers; i++) {
+        Subscriber* sub = &subscribers[i];
+        if (sub->inUse && now > sub->expires) {
+            sub->inUse = false;
+            updateStream(sub->stream);
+            printf("Lease expired for %s:%d\n", inet_ntoa(sub->addr.sin_addr), ntohs(sub->addr.sin_port));
+        }
+    }
+}
+
+/// <summary>
+/// Sends the latest sample to every stream that is due.
+/// </summary>
+void sendStreams(int sockfd, SimVars* latest, steady_clock::time_point now)
+{
+    static char packet[MaxDeltaSize];
+
+    for (int i = 0; i < MaxSubscribers; i++) {
+        Stream* stream = &streams[i];
+        if (!stream->inUse || now < stream->nextSend) {
+            continue;
+        }
+
+        bool keyframe = stream->keyframePending || stream->sinceKeyframe >= stream->keyframeInterval;
+        int bytes = encodeDelta(packet, &stream->prev, latest, ++stream->sequence, keyframe, stream->fields);
+        sendPacket(sockfd, packet, bytes, &stream->dest, now);
+
+        stream->prev = *latest;
+        if (keyframe) {
+            stream->keyframePending = false;
+            stream->sinceKeyframe = 0;
+        }
+        else {
+            stream->sinceKeyframe++;
+        }
+
+        stream->nextSend += microseconds(1000000 / stream->rate);
+        if (stream->nextSend < now) {
+            stream->nextSend = now;
+        }
+    }
+}
+
+/// <summary>
+/// Shows the sender's cost, which for multicast doesn't depend on
+/// the number of panels.
+/// </summary>
+void showStats(double secs)
+{
+    int subCount = 0;
+    int streamCount = 0;
+    for (int i = 0; i < MaxSubscribers; i++) {
+        if (subscribers[i].inUse) subCount++;
+        if (streams[i].inUse) streamCount++;
+    }
+
+    printf("Panels: %d  Streams: %d  Sent: %.1f packets/s  %.1f KB/s  Polls: %.1f/s  Writes: %lld  Dropped: %lld\n",
+        subCount, streamCount, sentPackets / secs, sentBytes / secs / 1024, polls / secs, writes, droppedPackets);
+
+    sentPackets = 0;
+    sentBytes = 0;
+    droppedPackets = 0;
+    polls = 0;
+    writes = 0;
+}
+
+
+/// <summary>
+/// Loads a recording to replay. Flight recordings can be replayed by
+/// any version, a file of SimVars structs must have been made with the
+/// same SimVars struct.
+/// </summary>
+bool loadRecording(const char* filename)
+{
+    FILE* infile = fopen(filename, "rb");
+    if (!infile) {
+        printf("Recording %s not found\n", filename);
+        return false;
+    }
+
+    uint32_t magic = 0;
+    if (fread(&magic, sizeof(magic), 1, infile) == 1 && magic == RecorderMagic) {
+        fclose(infile);
+        recordingCount = readFlightRecording(filename, &recording, &recordingTimes);
+        if (recordingCount <= 0) {
+            printf("Failed to read flight recording %s\n", filename);
+            return false;
+        }
+
+        double secs = (recordingTimes[recordingCount - 1] - recordingTimes[0]) / 1000000.0;
+        printf("Replaying %ld samples (%.1f secs) from %s\n", recordingCount, secs, filename);
+        return true;
+    }
+
+    fseek(infile, 0, SEEK_END);
+    long bytes = ftell(infile);
+    fseek(infile, 0, SEEK_SET);
+
+    if (bytes == 0 || bytes % sizeof(SimVars) != 0) {
+        printf("Recording %s doesn't match the SimVars struct\n", filename);
+        fclose(infile);
+        return false;
+    }
+
+    recordingCount = bytes / sizeof(SimVars);
+    recording = new SimVars[recordingCount];
+    if (fread(recording, sizeof(SimVars), recordingCount, infile) != (size_t)recordingCount) {
+        printf("Failed to read recording %s\n", filename);
+        fclose(infile);
+        return false;
+    }
+
+    fclose(infile);
+    printf("Replaying %ld samples from %s\n", recordingCount, filename);
+    return true;
+}
+
+/// <summary>
+/// Polls a real instrument-data-link at the sample rate and records
+/// what it sends so it can be replayed later.
+/// </summary>
+int capture(const char* host, int port, FILE* outfile)
+{
+    int sockfd;
+    if ((sockfd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP)) == -1) {
+        printf("Failed to create UDP socket\n");
+        return 1;
+    }
+
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (inet_pton(AF_INET, host, &addr.sin_addr) <= 0) {
+        printf("Invalid data link address: %s\n", host);
+        return 1;
+    }
+
+    printf("Capturing from %s:%d at %d samples/s (Ctrl-C to stop)\n", host, port, sampleRate);
+
+    long dataSize = sizeof(SimVars);
+    SimVars simVars;
+    long count = 0;
+    auto nextPoll = steady_clock::now();
+
+    while (!quit) {
+        sendto(sockfd, (char*)&dataSize, sizeof(long), 0, (sockaddr*)&addr, sizeof(addr));
+
+        fd_set fds;
+        FD_ZERO(&fds);
+        FD_SET(sockfd, &fds);
+        timeval timeout;
+        timeout.tv_sec = 0;
+        timeout.tv_usec = 500000;
+
+        if (select(sockfd + 1, &fds, NULL, NULL, &timeout) > 0) {
+            int bytes = recv(sockfd, (char*)&simVars, sizeof(simVars), 0);
+            if (bytes == sizeof(SimVars)) {
+                fwrite(&simVars, sizeof(SimVars), 1, outfile);
+                count++;
+            }
+            else if (bytes == sizeof(long)) {
+                printf("Data link has a different SimVars struct\n");
+                break;
+            }
+        }
+
+        nextPoll += microseconds(1000000 / sampleRate);
+        auto now = steady_clock::now();
+        if (nextPoll > now) {
+            usleep(duration_cast<microseconds>(nextPoll - now).count());
+        }
+        else {
+            nextPoll = now;
+        }
+    }
+
+    printf("Captured %ld samples\n", count);
+    close(sockfd);
+    return 0;
+}
+
+/// <summary>
+/// Handles a poll, write event or subscribe request from a panel.
+/// </summary>
+void handleRequest(int sockfd, SimVars* simVars, steady_clock::time_point now)
+{
+    char buf[sizeof(SubscribeRequest) + sizeof(WriteRequest)];
+    sockaddr_in from;
+    socklen_t fromLen = sizeof(from);
+    long dataSize = sizeof(SimVars);
+
+    int bytes = recvfrom(sockfd, buf, sizeof(buf), 0, (sockaddr*)&from, &fromLen);
+
+    if (bytes == sizeof(long)) {
+        // Poll. Reply with our size if the panel is expecting something else.
+        long requestSize;
+        memcpy(&requestSize, buf, sizeof(long));
+        polls++;
+        if (requestSize == dataSize) {
+            sendPacket(sockfd, (char*)simVars, sizeof(SimVars), &from, now);
+        }
+        else {
+            sendto(sockfd, (char*)&dataSize, sizeof(long), 0, (sockaddr*)&from, sizeof(from));
+        }
+    }
+    else if (bytes == sizeof(WriteRequest)) {
+        WriteRequest request;
+        memcpy(&request, buf, sizeof(request));
+        if (request.bytes == sizeof(WriteData)) {
+            writes++;
+            applyEvent(simVars, &request.writeData);
+        }
+    }
+    else if (bytes == sizeof(SubscribeRequest)) {
+        SubscribeRequest request;
+        memcpy(&request, buf, sizeof(request));
+        if (request.magic != SubscribeMagic) {
+            return;
+        }
+
+        if (request.dataSize == dataSize) {
+            subscribe(&request, &from);
+        }
+        else {
+            sendto(sockfd, (char*)&dataSize, sizeof(long), 0, (sockaddr*)&from, sizeof(from));
+        }
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int port = 52020;
+    const char* replayFile = NULL;
+    const char* recordFile = NULL;
+    char captureHost[64] = "";
+    int capturePort = 52020;
+
+    for (int i = 1; i < argc; i++) {
+        if (i + 1 >= argc) {
+            printf("Usage: data-link-stub [-p port] [-r rate] [-f replay_file] [-o record_file] [-c host[:port]] [-j jitter_ms] [-l loss_percent]\n");
+            return 1;
+        }
+
+        if (strcmp(argv[i], "-p") == 0) {
+            port = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-r") == 0) {
+            sampleRate = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-f") == 0) {
+            replayFile = argv[++i];
+        }
+        else if (strcmp(argv[i], "-o") == 0) {
+            recordFile = argv[++i];
+        }
+        else if (strcmp(argv[i], "-c") == 0) {
+            strncpy(captureHost, argv[++i], sizeof(captureHost) - 1);
+            char* colon = strchr(captureHost, ':');
+            if (colon) {
+                *colon = '\0';
+                capturePort = atoi(colon + 1);
+            }
+        }
+        else if (strcmp(argv[i], "-j") == 0) {
+            jitterMs = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-l") == 0) {
+            lossPercent = atof(argv[++i]);
+        }
+        else {
+            printf("Unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (sampleRate <= 0) {
+        printf("Rate must be at least 1\n");
+        return 1;
+    }
+
+    if (!initSimVarFields()) {
+        printf("SimVar definitions don't match the SimVars struct\n");
+        return 1;
+    }
+
+    // Keep output timely when logging to a file
+    setvbuf(stdout, NULL, _IOLBF, 0);
+
+    signal(SIGINT, stop);
+    signal(SIGTERM, stop);
+
+    FILE* outfile = NULL;
+    if (recordFile) {
+        if ((outfile = fopen(recordFile, "wb")) == NULL) {
+            printf("Failed to create %s\n", recordFile);
+            return 1;
+        }
+    }
+
+    if (captureHost[0] != '\0') {
+        if (!outfile) {
+            printf("Capture needs an output file (-o)\n");
+            return 1;
+        }
+
+        int result = capture(captureHost, capturePort, outfile);
+        fclose(outfile);
+        return result;
+    }
+
+    if (replayFile && !loadRecording(replayFile)) {
+        return 1;
+    }
+
+    delayed = new DelayedPacket[MaxDelayed];
+    srand(1);
+
+    int sockfd;
+    if ((sockfd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP)) == -1) {
+        printf("Failed to create UDP socket\n");
+        return 1;
+    }
+
+    sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    addr.sin_addr.s_addr = htonl(INADDR_ANY);
+
+    if (bind(sockfd, (sockaddr*)&addr, sizeof(addr)) != 0) {
+        printf("Failed to bind to port %d\n", port);
+        return 1;
+    }
+
+    // Make sure panels on this machine see multicast samples too
+    unsigned char loop = 1;
+    setsockopt(sockfd, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop));
+
+    printf("Data link stub listening on port %d at %d samples/s", port, sampleRate);
+    if (jitterMs > 0 || lossPercent > 0) {
+        printf(" with %d ms jitter and %g%% loss", jitterMs, lossPercent);
+    }
+    printf("\n");
+
+    SimVars simVars;
+    long sampleNum = -1;
+    auto startTime = steady_clock::now();
+    auto statsTime = startTime;
+
+    while (!quit) {
+        auto now = steady_clock::now();
+
+        // Wait for a request or until the next sample, stream or delayed packet is due
+        auto wakeTime = startTime + microseconds((sampleNum + 1) * 1000000 / sampleRate);
+        for (int i = 0; i < MaxSubscribers; i++) {
+            if (streams[i].inUse && streams[i].nextSend < wakeTime) {
+                wakeTime = streams[i].nextSend;
+            }
+        }
+        for (int i = 0; i < delayedCount; i++) {
+            if (delayed[i].due < wakeTime) {
+                wakeTime = delayed[i].due;
+            }
+        }
+
+        long long waitUs = duration_cast<microseconds>(wakeTime - now).count();
+        if (waitUs > 100000) {
+            waitUs = 100000;
+        }
+        timeval timeout;
+        timeout.tv_sec = 0;
+        timeout.tv_usec = waitUs > 0 ? waitUs : 0;
+
+        fd_set fds;
+        FD_ZERO(&fds);
+        FD_SET(sockfd, &fds);
+
+        if (select(sockfd + 1, &fds, NULL, NULL, &timeout) > 0) {
+            handleRequest(sockfd, &simVars, steady_clock::now());
+        }
+
+        now = steady_clock::now();
+
+        long latestNum = duration_cast<microseconds>(now - startTime).count() * sampleRate / 1000000;
+        if (latestNum != sampleNum) {
+            sampleNum = latestNum;
+            nextSample(&simVars, sampleNum);
+            if (outfile) {
+                fwrite(&simVars, sizeof(SimVars), 1, outfile);
+            }
+        }
+
+        expireSubscribers(now);
+        sendStreams(sockfd, &simVars, now);
+        sendDelayed(sockfd, now);
+
+        double statsSecs = duration<double>(now - statsTime).count();
+        if (statsSecs >= StatsIntervalSecs) {
+            showStats(statsSecs);
+            statsTime = now;
+        }
+    }
+
+    if (outfile) {
+        fclose(outfile);
+    }
+
+    close(sockfd);
+    return 0;
+}
@@ -0,0 +1,172 @@
+#include <stdio.h>
+#include <algorithm>
+#include "atlas.h"
+
+atlas::~atlas()
+{
+    // Instruments must have destroyed their sub-bitmaps first
+    for (int i = 0; i < pageCount; i++) {
+        al_destroy_bitmap(pages[i]);
+    }
+}
+
+/// <summary>
+/// Packs all current sprites into new pages. Sprites already in the
+/// atlas are packed again so a resized instrument doesn't leave holes.
+/// </summary>
+void atlas::build(std::list<instrument*>* instruments)
+{
+    globals.atlasStale = false;
+
+    // Memory bitmaps (headless) have no maximum size
+    int pageSize = MaxPageSize;
+    if (globals.display) {
+        pageSize = al_get_display_option(globals.display, ALLEGRO_MAX_BITMAP_SIZE);
+    }
+    if (pageSize <= 0 || pageSize > MaxPageSize) {
+        pageSize = MaxPageSize;
+    }
+
+    // Find all sprites of every variant
+    Sprite* sprites = new Sprite[instruments->size() * MaxBitmaps * MaxVariants];
+    int spriteCount = 0;
+
+    for (auto const& inst : *instruments) {
+        addSprites(sprites, &spriteCount, inst->bitmaps, inst->isTarget, inst->bitmapCount, pageSize);
+
+        for (int i = 0; i < MaxVariants; i++) {
+            if (i != inst->variant) {
+                instrument::BitmapSet* set = &inst->variants[i];
+                addSprites(sprites, &spriteCount, set->bitmaps, set->isTarget, set->count, pageSize);
+            }
+        }
+    }
+
+    // Pack onto shelves, tallest first
+    std::sort(sprites, sprites + spriteCount, [](const Sprite& a, const Sprite& b) { return a.height > b.height; });
+
+    int newCount = 0;
+    int pageWidth[MaxPages] = { 0 };
+    int pageHeight[MaxPages] = { 0 };
+    int x = 0;
+    int y = 0;
+    int shelfHeight = 0;
+
+    for (int i = 0; i < spriteCount; i++) {
+        Sprite* sprite = &sprites[i];
+
+        if (x + sprite->width + Padding > pageSize) {
+            // Start a new shelf
+            y += shelfHeight;
+            x = 0;
+            shelfHeight = 0;
+        }
+
+        if (newCount == 0 || y + sprite->height + Padding > pageSize) {
+            // Start a new page
+            if (newCount == MaxPages) {
+                continue;
+            }
+            newCount++;
+            x = 0;
+            y = 0;
+            shelfHeight = 0;
+        }
+
+        sprite->page = newCount - 1;
+        sprite->x = x;
+        sprite->y = y;
+
+        x += sprite->width + Padding;
+        if (sprite->height + Padding > shelfHeight) {
+            shelfHeight = sprite->height + Padding;
+        }
+        if (x > pageWidth[sprite->page]) {
+            pageWidth[sprite->page] = x;
+        }
+        if (y + shelfHeight > pageHeight[sprite->page]) {
+            pageHeight[sprite->page] = y + shelfHeight;
+        }
+    }
+
+    // Copy the sprites exactly (including alpha) onto the new pages
+    ALLEGRO_BITMAP* newPages[MaxPages] = { NULL };
+    for (int i = 0; i < newCount; i++) {
+        newPages[i] = al_create_bitmap(pageWidth[i], pageHeight[i]);
+        if (newPages[i]) {
+            al_set_target_bitmap(newPages[i]);
+            al_clear_to_color(al_map_rgba(0, 0, 0, 0));
+        }
+    }
+
+    al_set_blender(ALLEGRO_ADD, ALLEGRO_ONE, ALLEGRO_ZERO);
+
+    int packed = 0;
+    for (int i = 0; i < spriteCount; i++) {
+        Sprite* sprite = &sprites[i];
+        ALLEGRO_BITMAP* bitmap = *sprite->slot;
+        if (sprite->page == -1 || newPages[sprite->page] == NULL) {
+            if (al_is_sub_bitmap(bitmap)) {
+                // Didn't fit this time so must stop using the old page
+                *sprite->slot = al_clone_bitmap(bitmap);
+                al_destroy_bitmap(bitmap);
+            }
+            continue;
+        }
+
+        al_set_target_bitmap(newPages[sprite->page]);
+        al_draw_bitmap(bitmap, sprite->x, sprite->y, 0);
+
+        ALLEGRO_BITMAP* sub = al_create_sub_bitmap(newPages[sprite->page], sprite->x, sprite->y, sprite->width, sprite->height);
+        if (sub) {
+            al_destroy_bitmap(bitmap);
+            *sprite->slot = sub;
+            packed++;
+        }
+        else if (al_is_sub_bitmap(bitmap)) {
+            *sprite->slot = al_clone_bitmap(bitmap);
+            al_destroy_bitmap(bitmap);
+        }
+    }
+
+    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+    al_set_target_bitmap(globals.screen);
+
+    // Nothing refers to the old pages now
+    for (int i = 0; i < pageCount; i++) {
+        al_destroy_bitmap(pages[i]);
+    }
+
+    pageCount = 0;
+    for (int i = 0; i < newCount; i++) {
+        if (newPages[i]) {
+            pages[pageCount++] = newPages[i];
+        }
+    }
+
+    printf("Atlas: Packed %d sprites into %d textures\n", packed, pageCount);
+    delete[] sprites;
+}
+
+/// <summary>
+/// Adds the sprites from a set of instrument bitmaps, i.e. everything
+/// except the loaded bitmap and targets.
+/// </summary>
+void atlas::addSprites(Sprite* sprites, int* spriteCount, ALLEGRO_BITMAP** bitmaps, bool* isTarget, int bitmapCount, int pageSize)
+{
+    for (int i = 1; i < bitmapCount; i++) {
+        if (bitmaps[i] == NULL || isTarget[i]) {
+            continue;
+        }
+
+        Sprite* sprite = &sprites[*spriteCount];
+        sprite->slot = &bitmaps[i];
+        sprite->width = al_get_bitmap_width(bitmaps[i]);
+        sprite->height = al_get_bitmap_height(bitmaps[i]);
+        sprite->page = -1;
+
+        if (sprite->width + Padding <= pageSize && sprite->height + Padding <= pageSize) {
+            (*spriteCount)++;
+        }
+    }
+}
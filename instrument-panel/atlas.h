@@ -0,0 +1,42 @@
+#ifndef _ATLAS_H_
+#define _ATLAS_H_
+
+#include <list>
+#include <allegro5/allegro.h>
+#include "instrument.h"
+
+/// <summary>
+/// Packs the sprites of every instrument (dials, pointers, shadows,
+/// digits etc.) into as few textures as possible. Each sprite is replaced
+/// by a sub-bitmap of an atlas page so draws from the same page can be
+/// batched into a single draw call. Loaded bitmaps and bitmaps that
+/// render draws into are left as they are. Sprites of variants that
+/// aren't selected are packed too so selecting one needs no rebuild.
+/// </summary>
+class atlas
+{
+private:
+    static const int MaxPages = 8;
+    static const int MaxPageSize = 4096;
+    static const int Padding = 1;
+
+    struct Sprite {
+        ALLEGRO_BITMAP** slot;
+        int width;
+        int height;
+        int page;
+        int x;
+        int y;
+    };
+
+    ALLEGRO_BITMAP* pages[MaxPages] = { NULL };
+    int pageCount = 0;
+
+    void addSprites(Sprite* sprites, int* spriteCount, ALLEGRO_BITMAP** bitmaps, bool* isTarget, int bitmapCount, int pageSize);
+
+public:
+    ~atlas();
+    void build(std::list<instrument*>* instruments);
+};
+
+#endif // _ATLAS_H_
@@ -0,0 +1,120 @@
+#include <stdio.h>
+#include <string.h>
+#include "bitmapCache.h"
+#include "globals.h"
+#include "preloader.h"
+#include "bitmapPack.h"
+
+extern globalVars globals;
+
+bitmapCache::~bitmapCache()
+{
+    // Instruments must have released their bitmaps first
+    for (int i = 0; i < entryCount; i++) {
+        al_destroy_bitmap(entries[i].bitmap);
+    }
+}
+
+/// <summary>
+/// Loads a bitmap from the pack, the sheets decoded at startup or the
+/// bitmap directory, whichever has it first.
+/// </summary>
+ALLEGRO_BITMAP* bitmapCache::load(const char* filename)
+{
+    ALLEGRO_BITMAP* bitmap = NULL;
+    if (globals.assetPack) {
+        bitmap = globals.assetPack->load(filename);
+    }
+
+    if (!bitmap && globals.bitmapPreloader) {
+        bitmap = globals.bitmapPreloader->take(filename);
+    }
+
+    if (!bitmap) {
+        char filepath[256];
+        strcpy(filepath, globals.BitmapDir);
+        strcat(filepath, filename);
+        bitmap = al_load_bitmap(filepath);
+    }
+
+    return bitmap;
+}
+
+/// <summary>
+/// Returns the bitmap for a file, loading it if nobody has it yet. Every
+/// bitmap acquired must be given back with release. Returns NULL if the
+/// file can't be loaded.
+/// </summary>
+ALLEGRO_BITMAP* bitmapCache::acquire(const char* filename)
+{
+    for (int i = 0; i < entryCount; i++) {
+        if (strcmp(entries[i].filename, filename) == 0) {
+            entries[i].refs++;
+            return entries[i].bitmap;
+        }
+    }
+
+    ALLEGRO_BITMAP* bitmap = load(filename);
+    if (!bitmap) {
+        return NULL;
+    }
+
+    if (entryCount == MaxEntries) {
+        trim();
+    }
+
+    if (entryCount == MaxEntries || strlen(filename) >= (size_t)MaxNameSize) {
+        // Not shared so will be destroyed when released
+        return bitmap;
+    }
+
+    Entry* entry = &entries[entryCount++];
+    strcpy(entry->filename, filename);
+    entry->bitmap = bitmap;
+    entry->refs = 1;
+    return bitmap;
+}
+
+/// <summary>
+/// Gives back a bitmap from acquire. Returns false if the bitmap isn't
+/// shared, i.e. the caller must destroy it.
+/// </summary>
+bool bitmapCache::release(ALLEGRO_BITMAP* bitmap)
+{
+    if (!bitmap) {
+        return false;
+    }
+
+    for (int i = 0; i < entryCount; i++) {
+        if (entries[i].bitmap == bitmap) {
+            if (entries[i].refs > 0) {
+                entries[i].refs--;
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/// <summary>
+/// Destroys bitmaps nobody is using any more, e.g. the sheets of the
+/// previous aircraft.
+/// </summary>
+void bitmapCache::trim()
+{
+    int kept = 0;
+    for (int i = 0; i < entryCount; i++) {
+        if (entries[i].refs > 0) {
+            entries[kept++] = entries[i];
+        }
+        else {
+            al_destroy_bitmap(entries[i].bitmap);
+        }
+    }
+
+    if (kept != entryCount) {
+        printf("Bitmap cache: Freed %d bitmaps, %d in use\n", entryCount - kept, kept);
+        entryCount = kept;
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef _BITMAPCACHE_H_
+#define _BITMAPCACHE_H_
+
+#include <allegro5/allegro.h>
+
+/// <summary>
+/// Loaded bitmaps shared by every instrument. Each file is decoded and
+/// uploaded once and every instrument that loads it gets the same bitmap.
+/// Bitmaps are reference counted and one nobody uses is kept until trim
+/// is called, so resizing an instrument (which releases and then loads
+/// its sheet again) doesn't load anything.
+/// </summary>
+class bitmapCache
+{
+private:
+    static const int MaxEntries = 64;
+    static const int MaxNameSize = 64;
+
+    struct Entry {
+        char filename[MaxNameSize];
+        ALLEGRO_BITMAP* bitmap;
+        int refs;
+    };
+
+    Entry entries[MaxEntries];
+    int entryCount = 0;
+
+    ALLEGRO_BITMAP* load(const char* filename);
+
+public:
+    ~bitmapCache();
+    ALLEGRO_BITMAP* acquire(const char* filename);
+    bool release(ALLEGRO_BITMAP* bitmap);
+    void trim();
+};
+
+#endif // _BITMAPCACHE_H_
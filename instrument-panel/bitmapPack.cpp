@@ -0,0 +1,171 @@
+#include <stdio.h>
+#include <string.h>
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+#include "bitmapPack.h"
+#include "globals.h"
+
+extern globalVars globals;
+
+/// <summary>
+/// Maps the pack into memory. A missing pack is normal (bitmaps are
+/// loaded from PNGs instead) so is silently ignored.
+/// </summary>
+bitmapPack::bitmapPack(const char* filename)
+{
+#ifdef _WIN32
+    fileHandle = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        fileHandle = NULL;
+        return;
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(fileHandle, &size) || size.QuadPart < (long long)sizeof(PackHeader)) {
+        printf("Bitmap pack %s is empty\n", filename);
+        return;
+    }
+    mappedBytes = size.QuadPart;
+
+    mappingHandle = CreateFileMappingA(fileHandle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mappingHandle) {
+        mapped = (const char*)MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    }
+#else
+    fd = open(filename, O_RDONLY);
+    if (fd == -1) {
+        return;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size < (long long)sizeof(PackHeader)) {
+        printf("Bitmap pack %s is empty\n", filename);
+        return;
+    }
+    mappedBytes = st.st_size;
+
+    void* view = mmap(NULL, mappedBytes, PROT_READ, MAP_SHARED, fd, 0);
+    if (view != MAP_FAILED) {
+        mapped = (const char*)view;
+    }
+#endif
+
+    if (!mapped) {
+        printf("Failed to map bitmap pack %s\n", filename);
+        return;
+    }
+
+    const PackHeader* header = (const PackHeader*)mapped;
+    long long entryBytes = (long long)header->entryCount * sizeof(PackEntry);
+    if (header->magic != PackMagic || header->version != PackVersion || (long long)sizeof(PackHeader) + entryBytes > mappedBytes) {
+        printf("Ignoring bitmap pack %s as it is not version %d\n", filename, PackVersion);
+        return;
+    }
+
+    entries = (const PackEntry*)(mapped + sizeof(PackHeader));
+    entryCount = header->entryCount;
+    printf("Bitmap pack: %d bitmaps in %s\n", entryCount, filename);
+}
+
+bitmapPack::~bitmapPack()
+{
+#ifdef _WIN32
+    if (mapped) {
+        UnmapViewOfFile(mapped);
+    }
+    if (mappingHandle) {
+        CloseHandle(mappingHandle);
+    }
+    if (fileHandle) {
+        CloseHandle(fileHandle);
+    }
+#else
+    if (mapped) {
+        munmap((void*)mapped, mappedBytes);
+    }
+    if (fd != -1) {
+        close(fd);
+    }
+#endif
+}
+
+/// <summary>
+/// Returns the entry for a bitmap or NULL if it isn't in the pack or the
+/// PNG has changed since the pack was built.
+/// </summary>
+const PackEntry* bitmapPack::find(const char* filename)
+{
+    for (int i = 0; i < entryCount; i++) {
+        const PackEntry* entry = &entries[i];
+        if (strncmp(entry->name, filename, PackNameSize) != 0) {
+            continue;
+        }
+
+        if (entry->offset + (uint64_t)entry->width * entry->height * 4 > (uint64_t)mappedBytes) {
+            return NULL;
+        }
+
+        // A missing PNG is fine, e.g. only the pack was deployed
+        char filepath[256];
+        strcpy(filepath, globals.BitmapDir);
+        strcat(filepath, filename);
+
+        ALLEGRO_FS_ENTRY* source = al_create_fs_entry(filepath);
+        bool stale = false;
+        if (source && al_fs_entry_exists(source)) {
+            stale = al_get_fs_entry_size(source) != entry->sourceSize
+                || al_get_fs_entry_mtime(source) != entry->sourceTime;
+        }
+        if (source) {
+            al_destroy_fs_entry(source);
+        }
+
+        return stale ? NULL : entry;
+    }
+
+    return NULL;
+}
+
+bool bitmapPack::has(const char* filename)
+{
+    return find(filename) != NULL;
+}
+
+/// <summary>
+/// Creates a bitmap from the pack or returns NULL if the bitmap isn't in
+/// the pack. Pixels are already decoded and premultiplied so are copied
+/// straight into the locked bitmap.
+/// </summary>
+ALLEGRO_BITMAP* bitmapPack::load(const char* filename)
+{
+    const PackEntry* entry = find(filename);
+    if (!entry) {
+        return NULL;
+    }
+
+    ALLEGRO_BITMAP* bitmap = al_create_bitmap(entry->width, entry->height);
+    if (!bitmap) {
+        return NULL;
+    }
+
+    ALLEGRO_LOCKED_REGION* region = al_lock_bitmap(bitmap, ALLEGRO_PIXEL_FORMAT_ABGR_8888_LE, ALLEGRO_LOCK_WRITEONLY);
+    if (!region) {
+        al_destroy_bitmap(bitmap);
+        return NULL;
+    }
+
+    const char* pixels = mapped + entry->offset;
+    int rowBytes = entry->width * 4;
+    for (uint32_t y = 0; y < entry->height; y++) {
+        memcpy((char*)region->data + y * region->pitch, pixels + y * rowBytes, rowBytes);
+    }
+
+    al_unlock_bitmap(bitmap);
+    return bitmap;
+}
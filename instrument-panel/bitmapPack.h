@@ -0,0 +1,66 @@
+#ifndef _BITMAPPACK_H_
+#define _BITMAPPACK_H_
+
+#include <stdint.h>
+#include <allegro5/allegro.h>
+
+// Bitmap pack file format (little endian)
+//
+// Built offline by asset-packer from the bitmaps directory so the panel
+// doesn't have to inflate any PNGs at startup. The file starts with a
+// PackHeader followed by a PackEntry for every bitmap. Each entry points
+// at width * height pixels of premultiplied RGBA (ABGR_8888_LE), rows
+// tightly packed, starting on a PackAlign boundary.
+//
+// The size and modified time of each source PNG are stored so an entry
+// is ignored (and the PNG loaded instead) once the PNG has been changed.
+const uint32_t PackMagic = 0x4B504D42;
+const int PackVersion = 1;
+const int PackNameSize = 64;
+const int PackAlign = 64;
+const char* const PackFile = "bitmaps.pack";
+
+struct PackHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t reserved;
+};
+
+struct PackEntry {
+    char name[PackNameSize];
+    uint32_t width;
+    uint32_t height;
+    int64_t sourceSize;
+    int64_t sourceTime;
+    uint64_t offset;
+};
+
+/// <summary>
+/// Read only view of a bitmap pack. The whole file is mapped into memory
+/// and pixels are copied straight from the mapping into new bitmaps.
+/// </summary>
+class bitmapPack
+{
+private:
+#ifdef _WIN32
+    void* fileHandle = NULL;
+    void* mappingHandle = NULL;
+#else
+    int fd = -1;
+#endif
+    const char* mapped = NULL;
+    long long mappedBytes = 0;
+    const PackEntry* entries = NULL;
+    int entryCount = 0;
+
+    const PackEntry* find(const char* filename);
+
+public:
+    bitmapPack(const char* filename);
+    ~bitmapPack();
+    bool has(const char* filename);
+    ALLEGRO_BITMAP* load(const char* filename);
+};
+
+#endif // _BITMAPPACK_H_
@@ -0,0 +1,408 @@
+#include <stdio.h>
+#include <algorithm>
+#include "drawing.h"
+
+// Counts since the stats were last dumped
+static DrawCounts counts;
+static long long frames = 0;
+
+// Counts for the last complete frame
+static DrawCounts lastFrame;
+static DrawCounts frameStart;
+
+static bool held = false;
+static bool batchOpen = false;
+static const void* batchTexture = NULL;
+static const void* boundTexture = NULL;
+
+static ALLEGRO_SHADER* shader = NULL;
+static bool shading = false;
+static bool shadowing = false;
+
+// Vertex colour that tells the shader a sprite is a shadow
+static const ALLEGRO_COLOR ShadowTint = { 0, 0, 0, 0 };
+static const ALLEGRO_COLOR NormalTint = { 1, 1, 1, 1 };
+
+// Normal sprites are premultiplied so they can be drawn with the same
+// blender as shadows, which darken whatever is below by the shadow's
+// shade of grey (white has no effect). Brightness dims everything else.
+static const char* PixelShader =
+    "#ifdef GL_ES\n"
+    "precision mediump float;\n"
+    "#endif\n"
+    "uniform sampler2D al_tex;\n"
+    "uniform bool al_use_tex;\n"
+    "uniform float brightness;\n"
+    "varying vec4 varying_color;\n"
+    "varying vec2 varying_texcoord;\n"
+    "\n"
+    "void main()\n"
+    "{\n"
+    "    vec4 tex = al_use_tex ? texture2D(al_tex, varying_texcoord) : vec4(1.0);\n"
+    "    if (varying_color.a == 0.0) {\n"
+    "        gl_FragColor = vec4(0.0, 0.0, 0.0, tex.a * (1.0 - tex.g));\n"
+    "    }\n"
+    "    else {\n"
+    "        vec4 c = varying_color * tex;\n"
+    "        gl_FragColor = vec4(c.rgb * c.a * brightness, c.a);\n"
+    "    }\n"
+    "}\n";
+
+/// <summary>
+/// Counts a draw from the given texture. Sub-bitmaps share their parent's
+/// texture so draws from the same atlas page batch together.
+/// </summary>
+static void counted(const void* texture)
+{
+    counts.draws++;
+
+    if (!held || !batchOpen || texture != batchTexture) {
+        counts.drawCalls++;
+        batchTexture = texture;
+        batchOpen = true;
+    }
+
+    if (texture != boundTexture) {
+        counts.textureBinds++;
+        boundTexture = texture;
+    }
+}
+
+static void counted(ALLEGRO_BITMAP* bitmap)
+{
+    ALLEGRO_BITMAP* parent = al_get_parent_bitmap(bitmap);
+    counted(parent ? parent : bitmap);
+}
+
+/// <summary>
+/// Counts the pixels covered by a draw to the given rectangle, i.e. after
+/// the current transform and clipped to the target's clipping rectangle.
+/// If scaled the source is resampled to fill them.
+/// </summary>
+static void filled(float x, float y, float width, float height, bool scaled = false)
+{
+    float x2 = x + width;
+    float y2 = y + height;
+    const ALLEGRO_TRANSFORM* transform = al_get_current_transform();
+    al_transform_coordinates(transform, &x, &y);
+    al_transform_coordinates(transform, &x2, &y2);
+
+    int clipX, clipY, clipWidth, clipHeight;
+    al_get_clipping_rectangle(&clipX, &clipY, &clipWidth, &clipHeight);
+
+    float left = std::max(std::min(x, x2), (float)clipX);
+    float top = std::max(std::min(y, y2), (float)clipY);
+    float right = std::min(std::max(x, x2), (float)(clipX + clipWidth));
+    float bottom = std::min(std::max(y, y2), (float)(clipY + clipHeight));
+
+    if (right > left && bottom > top) {
+        long long pixels = (long long)((right - left) * (bottom - top));
+        counts.pixels += pixels;
+        if (scaled) {
+            counts.scaledPixels += pixels;
+        }
+    }
+}
+
+/// <summary>
+/// Rotated draws aren't clipped, so this over counts if they overhang.
+/// </summary>
+static void filledRotated(float width, float height, bool scaled = false)
+{
+    long long pixels = (long long)(width * height);
+    counts.pixels += pixels;
+    if (scaled) {
+        counts.scaledPixels += pixels;
+    }
+}
+
+static ALLEGRO_COLOR tint()
+{
+    return shadowing ? ShadowTint : NormalTint;
+}
+
+/// <summary>
+/// Builds the shader used for shadows and dimming. The display must have
+/// been created with ALLEGRO_PROGRAMMABLE_PIPELINE. Returns false if the
+/// shader isn't supported, in which case the blender is used instead.
+/// </summary>
+bool initShaders()
+{
+    shader = al_create_shader(ALLEGRO_SHADER_GLSL);
+    if (!shader) {
+        return false;
+    }
+
+    const char* vertexShader = al_get_default_shader_source(ALLEGRO_SHADER_GLSL, ALLEGRO_VERTEX_SHADER);
+    if (!al_attach_shader_source(shader, ALLEGRO_VERTEX_SHADER, vertexShader)
+        || !al_attach_shader_source(shader, ALLEGRO_PIXEL_SHADER, PixelShader)
+        || !al_build_shader(shader)) {
+        printf("Shader failed: %s\n", al_get_shader_log(shader));
+        al_destroy_shader(shader);
+        shader = NULL;
+        return false;
+    }
+
+    return true;
+}
+
+void destroyShaders()
+{
+    if (shader) {
+        al_destroy_shader(shader);
+        shader = NULL;
+    }
+}
+
+bool haveShaders()
+{
+    return shader != NULL;
+}
+
+/// <summary>
+/// Draws with the shader until called again with false. Only the
+/// targets set while shading use the shader.
+/// </summary>
+void useShaders(bool use)
+{
+    if (!shader || use == shading) {
+        return;
+    }
+
+    if (held) {
+        al_hold_bitmap_drawing(false);
+    }
+
+    shading = use;
+    shadowing = false;
+    batchOpen = false;
+
+    if (use) {
+        al_use_shader(shader);
+        al_set_shader_float("brightness", 1);
+        al_set_blender(ALLEGRO_ADD, ALLEGRO_ONE, ALLEGRO_INVERSE_ALPHA);
+    }
+    else {
+        al_use_shader(NULL);
+        al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+    }
+
+    if (held) {
+        al_hold_bitmap_drawing(true);
+    }
+}
+
+void holdDrawing(bool hold)
+{
+    if (hold != held) {
+        held = hold;
+        batchOpen = false;
+        al_hold_bitmap_drawing(hold);
+    }
+}
+
+void setTarget(ALLEGRO_BITMAP* bitmap)
+{
+    if (bitmap == al_get_target_bitmap()) {
+        return;
+    }
+
+    if (held) {
+        al_hold_bitmap_drawing(false);
+    }
+
+    al_set_target_bitmap(bitmap);
+    counts.targetSwitches++;
+
+    if (shading) {
+        // Each target has its own shader
+        al_use_shader(shader);
+    }
+    batchOpen = false;
+
+    if (held) {
+        al_hold_bitmap_drawing(true);
+    }
+}
+
+void setBlender(int op, int src, int dst)
+{
+    if (shading && src == ALLEGRO_ALPHA && dst == ALLEGRO_INVERSE_ALPHA) {
+        // Shader premultiplies alpha
+        src = ALLEGRO_ONE;
+    }
+
+    int curOp, curSrc, curDst;
+    al_get_blender(&curOp, &curSrc, &curDst);
+    if (op == curOp && src == curSrc && dst == curDst) {
+        return;
+    }
+
+    if (held) {
+        al_hold_bitmap_drawing(false);
+    }
+
+    al_set_blender(op, src, dst);
+    batchOpen = false;
+
+    if (held) {
+        al_hold_bitmap_drawing(true);
+    }
+}
+
+/// <summary>
+/// Sets the brightness of everything drawn (except shadows) while
+/// shading, e.g. to dim an instrument.
+/// </summary>
+void setBrightness(float brightness)
+{
+    if (!shading) {
+        return;
+    }
+
+    if (held) {
+        al_hold_bitmap_drawing(false);
+    }
+
+    al_set_shader_float("brightness", brightness);
+    batchOpen = false;
+
+    if (held) {
+        al_hold_bitmap_drawing(true);
+    }
+}
+
+/// <summary>
+/// Bitmaps drawn until endShadows is called are shadows, i.e. they
+/// multiply whatever is below them (shades of grey darken, white has no
+/// effect). When shading the shader does the multiply so nothing needs
+/// to change and shadows batch with the sprites drawn after them.
+/// </summary>
+void beginShadows()
+{
+    if (shading) {
+        shadowing = true;
+    }
+    else {
+        setBlender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
+    }
+}
+
+void endShadows()
+{
+    if (shading) {
+        shadowing = false;
+    }
+    else {
+        setBlender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+    }
+}
+
+void setClipping(int x, int y, int width, int height)
+{
+    if (held) {
+        al_hold_bitmap_drawing(false);
+    }
+
+    al_set_clipping_rectangle(x, y, width, height);
+    batchOpen = false;
+
+    if (held) {
+        al_hold_bitmap_drawing(true);
+    }
+}
+
+void drawBitmap(ALLEGRO_BITMAP* bitmap, float dx, float dy, int flags)
+{
+    counted(bitmap);
+    filled(dx, dy, al_get_bitmap_width(bitmap), al_get_bitmap_height(bitmap));
+    al_draw_tinted_bitmap(bitmap, tint(), dx, dy, flags);
+}
+
+void drawBitmapRegion(ALLEGRO_BITMAP* bitmap, float sx, float sy, float sw, float sh, float dx, float dy, int flags)
+{
+    counted(bitmap);
+    filled(dx, dy, sw, sh);
+    al_draw_tinted_bitmap_region(bitmap, tint(), sx, sy, sw, sh, dx, dy, flags);
+}
+
+void drawScaledBitmap(ALLEGRO_BITMAP* bitmap, float sx, float sy, float sw, float sh, float dx, float dy, float dw, float dh, int flags)
+{
+    counted(bitmap);
+    filled(dx, dy, dw, dh, dw != sw || dh != sh);
+    al_draw_tinted_scaled_bitmap(bitmap, tint(), sx, sy, sw, sh, dx, dy, dw, dh, flags);
+}
+
+void drawRotatedBitmap(ALLEGRO_BITMAP* bitmap, float cx, float cy, float dx, float dy, float angle, int flags)
+{
+    counted(bitmap);
+    filledRotated(al_get_bitmap_width(bitmap), al_get_bitmap_height(bitmap));
+    al_draw_tinted_rotated_bitmap(bitmap, tint(), cx, cy, dx, dy, angle, flags);
+}
+
+void drawScaledRotatedBitmap(ALLEGRO_BITMAP* bitmap, float cx, float cy, float dx, float dy, float xscale, float yscale, float angle, int flags)
+{
+    counted(bitmap);
+    filledRotated(al_get_bitmap_width(bitmap) * xscale, al_get_bitmap_height(bitmap) * yscale, xscale != 1 || yscale != 1);
+    al_draw_tinted_scaled_rotated_bitmap(bitmap, tint(), cx, cy, dx, dy, xscale, yscale, angle, flags);
+}
+
+void drawText(const ALLEGRO_FONT* font, ALLEGRO_COLOR color, float x, float y, int flags, const char* text)
+{
+    // Glyphs all come from the font's own texture
+    counted((const void*)font);
+    filled(x, y, al_get_text_width(font, text), al_get_font_line_height(font));
+    al_draw_text(font, color, x, y, flags, text);
+}
+
+/// <summary>
+/// Call once the frame has been flipped
+/// </summary>
+void drawFrameDone()
+{
+    batchOpen = false;
+    boundTexture = NULL;
+
+    lastFrame.draws = counts.draws - frameStart.draws;
+    lastFrame.drawCalls = counts.drawCalls - frameStart.drawCalls;
+    lastFrame.textureBinds = counts.textureBinds - frameStart.textureBinds;
+    lastFrame.targetSwitches = counts.targetSwitches - frameStart.targetSwitches;
+    lastFrame.pixels = counts.pixels - frameStart.pixels;
+    lastFrame.scaledPixels = counts.scaledPixels - frameStart.scaledPixels;
+    frameStart = counts;
+    frames++;
+}
+
+/// <summary>
+/// Shows the average draws per frame since the stats were last shown and
+/// the counts for the last frame, then starts again.
+/// </summary>
+void dumpDrawStats(FILE* outfile)
+{
+    if (frames == 0) {
+        fprintf(outfile, "No frames drawn\n");
+        return;
+    }
+
+    fprintf(outfile, "Drawing per frame (%lld frames)\n", frames);
+    fprintf(outfile, "  %-16s %8s %8s\n", "", "average", "last");
+    fprintf(outfile, "  %-16s %8.1f %8lld\n", "bitmaps drawn", (double)frameStart.draws / frames, lastFrame.draws);
+    fprintf(outfile, "  %-16s %8.1f %8lld\n", "draw calls", (double)frameStart.drawCalls / frames, lastFrame.drawCalls);
+    fprintf(outfile, "  %-16s %8.1f %8lld\n", "texture binds", (double)frameStart.textureBinds / frames, lastFrame.textureBinds);
+    fprintf(outfile, "  %-16s %8.1f %8lld\n", "target switches", (double)frameStart.targetSwitches / frames, lastFrame.targetSwitches);
+    fprintf(outfile, "  %-16s %8.1f %8lld\n", "kpixels filled", (double)frameStart.pixels / frames / 1000, lastFrame.pixels / 1000);
+    fprintf(outfile, "  %-16s %8.1f %8lld\n", "kpixels scaled", (double)frameStart.scaledPixels / frames / 1000, lastFrame.scaledPixels / 1000);
+
+    counts = DrawCounts();
+    frameStart = DrawCounts();
+    frames = 0;
+}
+
+/// <summary>
+/// Returns the running counts, e.g. to find out what drawing one
+/// instrument costs by comparing them before and after it renders.
+/// </summary>
+DrawCounts drawCounts()
+{
+    return counts;
+}
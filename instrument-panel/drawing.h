@@ -0,0 +1,60 @@
+#ifndef _DRAWING_H_
+#define _DRAWING_H_
+
+#include <stdio.h>
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_font.h>
+
+// Per frame drawing used by render. While drawing is held (see
+// holdDrawing) consecutive draws from the same texture are sent to the
+// GPU as a single draw call, so sprites packed into the same atlas page
+// batch together. Allegro doesn't allow the target, blender or clipping
+// to change while drawing is held so these must be changed with
+// setTarget, setBlender and setClipping which end the current batch
+// first. Transforms can be changed at any time.
+//
+// The counts are estimates of what the GPU is asked to do, i.e. a draw
+// call is counted for every batch and a texture bind every time the
+// source texture changes. Pixels filled (the fill rate) counts the
+// destination area of every draw and pixels scaled counts the part of
+// it where the source had to be resampled, i.e. scaled draws.
+//
+// Shadows are drawn between beginShadows and endShadows. Normally this
+// switches the blender to multiply and back. If shaders are in use (see
+// useShaders) the shader does the multiply instead so there is no state
+// change and a pointer and its shadow can be drawn in a single batch.
+
+struct DrawCounts {
+    long long draws = 0;
+    long long drawCalls = 0;
+    long long textureBinds = 0;
+    long long targetSwitches = 0;
+    long long pixels = 0;
+    long long scaledPixels = 0;
+};
+
+bool initShaders();
+void destroyShaders();
+bool haveShaders();
+void useShaders(bool use);
+
+void holdDrawing(bool hold);
+void setTarget(ALLEGRO_BITMAP* bitmap);
+void setBlender(int op, int src, int dst);
+void setClipping(int x, int y, int width, int height);
+void setBrightness(float brightness);
+void beginShadows();
+void endShadows();
+
+void drawBitmap(ALLEGRO_BITMAP* bitmap, float dx, float dy, int flags);
+void drawBitmapRegion(ALLEGRO_BITMAP* bitmap, float sx, float sy, float sw, float sh, float dx, float dy, int flags);
+void drawScaledBitmap(ALLEGRO_BITMAP* bitmap, float sx, float sy, float sw, float sh, float dx, float dy, float dw, float dh, int flags);
+void drawRotatedBitmap(ALLEGRO_BITMAP* bitmap, float cx, float cy, float dx, float dy, float angle, int flags);
+void drawScaledRotatedBitmap(ALLEGRO_BITMAP* bitmap, float cx, float cy, float dx, float dy, float xscale, float yscale, float angle, int flags);
+void drawText(const ALLEGRO_FONT* font, ALLEGRO_COLOR color, float x, float y, int flags, const char* text);
+
+void drawFrameDone();
+void dumpDrawStats(FILE* outfile);
+DrawCounts drawCounts();
+
+#endif // _DRAWING_H_
@@ -0,0 +1,439 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#endif
+#include "flightRecorder.h"
+
+// How often the writer thread wakes to store queued samples
+const int WriterSleepMs = 10;
+
+// How often written pages are handed to the OS to write out
+const int SyncIntervalMs = 1000;
+
+static long long roundUp(long long bytes, long long align)
+{
+    return (bytes + align - 1) / align * align;
+}
+
+/// <summary>
+/// Creates the recording file and starts the writer thread. If anything
+/// fails the error is shown and recording stays off.
+/// </summary>
+flightRecorder::flightRecorder(const char* filename)
+{
+    // Work out where each column lives in a segment
+    long long offset = sizeof(RecorderSegmentHeader) + RowsPerSegment * sizeof(int64_t);
+    for (int i = 0; i < SimVarFieldCount; i++) {
+        if (SimVarFields[i].isString) {
+            doubleColumn[i] = -1;
+            stringFieldCount++;
+        }
+        else {
+            doubleColumn[i] = offset;
+            offset += RowsPerSegment * sizeof(double);
+        }
+    }
+    stringsOffset = offset;
+    offset += StringsPerSegment * sizeof(RecorderStringChange);
+
+    segmentBytes = roundUp(offset, RecorderAlign);
+    headerBytes = roundUp(sizeof(RecorderFileHeader), RecorderAlign);
+
+#ifdef _WIN32
+    fileHandle = CreateFileA(filename, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        fileHandle = NULL;
+        printf("Failed to create flight recording %s\n", filename);
+        return;
+    }
+#else
+    fd = open(filename, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd == -1) {
+        printf("Failed to create flight recording %s\n", filename);
+        return;
+    }
+#endif
+
+    // Preallocate the header and the first two segments
+    if (!growFile(headerBytes + 2 * segmentBytes)) {
+        printf("Failed to allocate space for flight recording %s\n", filename);
+        return;
+    }
+
+    char* mapped = mapRegion(0, headerBytes);
+    if (!mapped) {
+        printf("Failed to map flight recording %s\n", filename);
+        return;
+    }
+
+    startWallUs = deltaTimestamp();
+    startMonoUs = latency::now();
+
+    RecorderFileHeader* header = (RecorderFileHeader*)mapped;
+    header->magic = RecorderMagic;
+    header->version = RecorderVersion;
+    header->fieldCount = SimVarFieldCount;
+    header->segmentBytes = (uint32_t)segmentBytes;
+    header->rowsPerSegment = RowsPerSegment;
+    header->stringsPerSegment = StringsPerSegment;
+    header->startTime = startWallUs;
+    for (int i = 0; i < SimVarFieldCount; i++) {
+        header->isString[i] = SimVarFields[i].isString;
+        strncpy(header->names[i], SimVarFields[i].name, RecorderNameSize - 1);
+    }
+    unmapRegion(mapped, headerBytes);
+
+    segmentNum = 0;
+    segment = mapSegment(0);
+    nextSegment = mapSegment(1);
+    if (!segment || !nextSegment) {
+        printf("Failed to map flight recording %s\n", filename);
+        return;
+    }
+
+    ring = new Sample[RingSize];
+    recording = true;
+    writerThread = new std::thread(&flightRecorder::writer, this);
+    printf("Recording flight to %s\n", filename);
+}
+
+/// <summary>
+/// Stores anything still queued and trims the preallocated space that
+/// wasn't used.
+/// </summary>
+flightRecorder::~flightRecorder()
+{
+    if (writerThread) {
+        stopping = true;
+        writerThread->join();
+        delete writerThread;
+    }
+
+    if (segment) {
+        unmapRegion(segment, segmentBytes);
+    }
+    if (nextSegment) {
+        unmapRegion(nextSegment, segmentBytes);
+    }
+
+    if (recording) {
+        growFile(headerBytes + (segmentNum + 1) * segmentBytes);
+        printf("Recorded %llu samples (%llu dropped)\n", (unsigned long long)rowsWritten, (unsigned long long)dropped.load());
+    }
+
+#ifdef _WIN32
+    if (fileHandle) {
+        CloseHandle(fileHandle);
+    }
+#else
+    if (fd != -1) {
+        close(fd);
+    }
+#endif
+
+    if (ring) {
+        delete[] ring;
+    }
+}
+
+/// <summary>
+/// Called by the data link thread for every sample received. Only copies
+/// the sample so it never waits on the disk. If the writer has fallen
+/// too far behind the sample is dropped.
+/// </summary>
+void flightRecorder::record(const SimVars* simVars, int64_t receiveTime)
+{
+    if (!recording) {
+        return;
+    }
+
+    uint32_t pos = head.load(std::memory_order_relaxed);
+    if (pos - tail.load(std::memory_order_acquire) >= RingSize) {
+        dropped++;
+        return;
+    }
+
+    Sample* sample = &ring[pos % RingSize];
+    sample->time = receiveTime;
+    memcpy(&sample->simVars, simVars, sizeof(SimVars));
+    head.store(pos + 1, std::memory_order_release);
+}
+
+/// <summary>
+/// Sets the file size, allocating the space on disk when growing so
+/// writing to the mapped pages can't fail later.
+/// </summary>
+bool flightRecorder::growFile(long long bytes)
+{
+#ifdef _WIN32
+    LARGE_INTEGER size;
+    size.QuadPart = bytes;
+    return SetFilePointerEx(fileHandle, size, NULL, FILE_BEGIN) && SetEndOfFile(fileHandle);
+#else
+    if (ftruncate(fd, bytes) != 0) {
+        return false;
+    }
+    return posix_fallocate(fd, 0, bytes) == 0;
+#endif
+}
+
+char* flightRecorder::mapRegion(long long offset, long long bytes)
+{
+#ifdef _WIN32
+    LARGE_INTEGER size;
+    size.QuadPart = offset + bytes;
+    HANDLE mapping = CreateFileMappingA(fileHandle, NULL, PAGE_READWRITE, size.HighPart, size.LowPart, NULL);
+    if (!mapping) {
+        return NULL;
+    }
+
+    LARGE_INTEGER start;
+    start.QuadPart = offset;
+    void* mapped = MapViewOfFile(mapping, FILE_MAP_WRITE, start.HighPart, start.LowPart, (SIZE_T)bytes);
+
+    // View keeps the mapping open
+    CloseHandle(mapping);
+    return (char*)mapped;
+#else
+    void* mapped = mmap(NULL, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, offset);
+    return mapped == MAP_FAILED ? NULL : (char*)mapped;
+#endif
+}
+
+void flightRecorder::unmapRegion(char* mapped, long long bytes)
+{
+#ifdef _WIN32
+    UnmapViewOfFile(mapped);
+#else
+    munmap(mapped, bytes);
+#endif
+}
+
+void flightRecorder::syncRegion(char* mapped, long long bytes)
+{
+#ifdef _WIN32
+    FlushViewOfFile(mapped, (SIZE_T)bytes);
+#else
+    msync(mapped, bytes, MS_ASYNC);
+#endif
+}
+
+char* flightRecorder::mapSegment(int num)
+{
+    char* mapped = mapRegion(headerBytes + num * segmentBytes, segmentBytes);
+    if (mapped) {
+        ((RecorderSegmentHeader*)mapped)->magic = RecorderSegmentMagic;
+    }
+    return mapped;
+}
+
+/// <summary>
+/// Makes sure the segment after the current one is allocated and mapped.
+/// </summary>
+bool flightRecorder::nextSegmentReady()
+{
+    if (nextSegment) {
+        return true;
+    }
+
+    if (!growFile(headerBytes + (segmentNum + 2) * segmentBytes)) {
+        return false;
+    }
+
+    nextSegment = mapSegment(segmentNum + 1);
+    return nextSegment != NULL;
+}
+
+void flightRecorder::addString(RecorderSegmentHeader* header, int row, int field, const char* value)
+{
+    RecorderStringChange* change = (RecorderStringChange*)(segment + stringsOffset) + header->stringCount;
+    change->row = row;
+    change->field = field;
+    strncpy(change->value, value, RecorderStringSize - 1);
+    header->stringCount++;
+}
+
+void flightRecorder::writeRow(Sample* sample)
+{
+    RecorderSegmentHeader* header = (RecorderSegmentHeader*)segment;
+
+    if (header->rowCount == RowsPerSegment || header->stringCount + stringFieldCount > StringsPerSegment) {
+        // Segment full so move on to the preallocated one
+        if (!nextSegmentReady()) {
+            dropped++;
+            return;
+        }
+
+        syncRegion(segment, segmentBytes);
+        unmapRegion(segment, segmentBytes);
+        segment = nextSegment;
+        nextSegment = NULL;
+        segmentNum++;
+        header = (RecorderSegmentHeader*)segment;
+    }
+
+    int row = header->rowCount;
+    ((int64_t*)(segment + sizeof(RecorderSegmentHeader)))[row] = startWallUs + sample->time - startMonoUs;
+
+    for (int i = 0; i < SimVarFieldCount; i++) {
+        const char* val = (const char*)&sample->simVars + SimVarFields[i].offset;
+
+        if (doubleColumn[i] != -1) {
+            ((double*)(segment + doubleColumn[i]))[row] = *(const double*)val;
+        }
+        else if (row == 0 || strncmp(val, (const char*)&lastSample + SimVarFields[i].offset, SimVarFields[i].size) != 0) {
+            addString(header, row, i, val);
+        }
+    }
+
+    memcpy(&lastSample, &sample->simVars, sizeof(SimVars));
+
+    // Row is complete
+    header->rowCount = row + 1;
+    rowsWritten++;
+}
+
+/// <summary>
+/// Writer thread. Stores queued samples and gets the next segment ready
+/// well before it is needed.
+/// </summary>
+void flightRecorder::writer()
+{
+    auto lastSync = std::chrono::steady_clock::now();
+
+    while (true) {
+        bool stop = stopping;
+
+        uint32_t pos = tail.load(std::memory_order_relaxed);
+        while (pos != head.load(std::memory_order_acquire)) {
+            writeRow(&ring[pos % RingSize]);
+            pos++;
+            tail.store(pos, std::memory_order_release);
+        }
+
+        if (stop) {
+            break;
+        }
+
+        nextSegmentReady();
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastSync > std::chrono::milliseconds(SyncIntervalMs)) {
+            syncRegion(segment, segmentBytes);
+            lastSync = now;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(WriterSleepMs));
+    }
+}
+
+/// <summary>
+/// Reads a flight recording back into an array of samples and their
+/// receive times (us since epoch). Fields are matched by name so older
+/// recordings can still be read. Returns the number of samples or -1
+/// if the file isn't a valid recording.
+/// </summary>
+long readFlightRecording(const char* filename, SimVars** samples, int64_t** times)
+{
+    FILE* infile = fopen(filename, "rb");
+    if (!infile) {
+        return -1;
+    }
+
+    RecorderFileHeader* header = new RecorderFileHeader();
+    if (fread(header, sizeof(RecorderFileHeader), 1, infile) != 1 || header->magic != RecorderMagic
+        || header->version != RecorderVersion || header->fieldCount > MaxSimVarFields) {
+        delete header;
+        fclose(infile);
+        return -1;
+    }
+
+    long long headerBytes = roundUp(sizeof(RecorderFileHeader), RecorderAlign);
+    long long segmentBytes = header->segmentBytes;
+    int rows = header->rowsPerSegment;
+
+    // Match recorded fields to ours and find their columns
+    int fieldMap[MaxSimVarFields];
+    long long column[MaxSimVarFields];
+    long long offset = sizeof(RecorderSegmentHeader) + rows * sizeof(int64_t);
+    for (unsigned int i = 0; i < header->fieldCount; i++) {
+        header->names[i][RecorderNameSize - 1] = '\0';
+        fieldMap[i] = -1;
+        for (int j = 0; j < SimVarFieldCount; j++) {
+            if (strcmp(header->names[i], SimVarFields[j].name) == 0 && header->isString[i] == SimVarFields[j].isString) {
+                fieldMap[i] = j;
+                break;
+            }
+        }
+
+        if (header->isString[i]) {
+            column[i] = -1;
+        }
+        else {
+            column[i] = offset;
+            offset += rows * sizeof(double);
+        }
+    }
+    long long stringsOffset = offset;
+
+    // Count complete rows
+    long count = 0;
+    RecorderSegmentHeader segHeader;
+    for (int seg = 0; ; seg++) {
+        if (fseek(infile, (long)(headerBytes + seg * segmentBytes), SEEK_SET) != 0
+            || fread(&segHeader, sizeof(segHeader), 1, infile) != 1
+            || segHeader.magic != RecorderSegmentMagic || segHeader.rowCount == 0) {
+            break;
+        }
+        count += segHeader.rowCount;
+    }
+
+    *samples = new SimVars[count > 0 ? count : 1];
+    *times = new int64_t[count > 0 ? count : 1];
+
+    char* segment = new char[segmentBytes];
+    SimVars current;
+    long sampleNum = 0;
+
+    for (int seg = 0; sampleNum < count; seg++) {
+        fseek(infile, (long)(headerBytes + seg * segmentBytes), SEEK_SET);
+        if (fread(segment, 1, segmentBytes, infile) < (size_t)stringsOffset) {
+            break;
+        }
+
+        RecorderSegmentHeader* segHead = (RecorderSegmentHeader*)segment;
+        RecorderStringChange* changes = (RecorderStringChange*)(segment + stringsOffset);
+        unsigned int changeNum = 0;
+
+        for (unsigned int row = 0; row < segHead->rowCount && sampleNum < count; row++) {
+            for (unsigned int i = 0; i < header->fieldCount; i++) {
+                if (column[i] != -1 && fieldMap[i] != -1) {
+                    *(double*)((char*)&current + SimVarFields[fieldMap[i]].offset) = ((double*)(segment + column[i]))[row];
+                }
+            }
+
+            while (changeNum < segHead->stringCount && changes[changeNum].row == row) {
+                RecorderStringChange* change = &changes[changeNum++];
+                if (change->field < header->fieldCount && fieldMap[change->field] != -1) {
+                    SimVarField* field = &SimVarFields[fieldMap[change->field]];
+                    strncpy((char*)&current + field->offset, change->value, field->size - 1);
+                }
+            }
+
+            (*times)[sampleNum] = ((int64_t*)(segment + sizeof(RecorderSegmentHeader)))[row];
+            (*samples)[sampleNum++] = current;
+        }
+    }
+
+    delete[] segment;
+    delete header;
+    fclose(infile);
+    return sampleNum;
+}
@@ -0,0 +1,120 @@
+#ifndef _FLIGHTRECORDER_H_
+#define _FLIGHTRECORDER_H_
+
+#include <thread>
+#include <atomic>
+#include "simvarDelta.h"
+#include "latency.h"
+
+// Flight recording file format (little endian)
+//
+// The file starts with a RecorderFileHeader (padded to RecorderAlign)
+// followed by fixed size segments, each holding up to rowsPerSegment
+// samples in columns:
+//
+//   RecorderSegmentHeader
+//   int64_t time[rowsPerSegment]           (receive time, us since epoch)
+//   double column[rowsPerSegment]          (one per double field, in field order)
+//   RecorderStringChange[stringsPerSegment]
+//
+// Strings rarely change so only changes are stored. Every segment starts
+// with the value of every string field at row 0 so it can be read on its
+// own. rowCount is only updated once a row is complete, so a recording
+// that was cut short can still be read up to the last complete row.
+const uint32_t RecorderMagic = 0x52565346;
+const uint32_t RecorderSegmentMagic = 0x47455346;
+const int RecorderVersion = 1;
+const int RecorderNameSize = 64;
+const int RecorderStringSize = 256;
+const int RecorderAlign = 65536;
+
+struct RecorderFileHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t fieldCount;
+    uint32_t segmentBytes;
+    uint32_t rowsPerSegment;
+    uint32_t stringsPerSegment;
+    int64_t startTime;
+    uint8_t isString[MaxSimVarFields];
+    char names[MaxSimVarFields][RecorderNameSize];
+};
+
+struct RecorderSegmentHeader {
+    uint32_t magic;
+    uint32_t rowCount;
+    uint32_t stringCount;
+    uint32_t reserved;
+};
+
+struct RecorderStringChange {
+    uint32_t row;
+    uint32_t field;
+    char value[RecorderStringSize];
+};
+
+/// <summary>
+/// Records every sample received by the data link thread. The data link
+/// thread only copies the sample into a ring buffer, a separate writer
+/// thread stores it in memory mapped segments which are preallocated
+/// ahead of time so the file never has to grow on a busy SD card.
+/// </summary>
+class flightRecorder {
+private:
+    static const int RingSize = 512;
+    static const int RowsPerSegment = 6000;
+    static const int StringsPerSegment = 256;
+
+    struct Sample {
+        int64_t time;
+        SimVars simVars;
+    };
+
+    // Ring buffer from the data link thread to the writer thread
+    Sample* ring = NULL;
+    std::atomic<uint32_t> head{ 0 };
+    std::atomic<uint32_t> tail{ 0 };
+    std::atomic<bool> stopping{ false };
+    std::atomic<uint64_t> dropped{ 0 };
+    std::thread* writerThread = NULL;
+
+    // Writer thread only
+#ifdef _WIN32
+    void* fileHandle = NULL;
+#else
+    int fd = -1;
+#endif
+    long long headerBytes = 0;
+    long long segmentBytes = 0;
+    long long doubleColumn[MaxSimVarFields];
+    int stringFieldCount = 0;
+    long long stringsOffset = 0;
+    int segmentNum = -1;
+    char* segment = NULL;
+    char* nextSegment = NULL;
+    SimVars lastSample;
+    int64_t startWallUs = 0;
+    int64_t startMonoUs = 0;
+    uint64_t rowsWritten = 0;
+
+    bool growFile(long long bytes);
+    char* mapRegion(long long offset, long long bytes);
+    void unmapRegion(char* mapped, long long bytes);
+    void syncRegion(char* mapped, long long bytes);
+    char* mapSegment(int num);
+    bool nextSegmentReady();
+    void writeRow(Sample* sample);
+    void addString(RecorderSegmentHeader* header, int row, int field, const char* value);
+    void writer();
+
+public:
+    bool recording = false;
+
+    flightRecorder(const char* filename);
+    ~flightRecorder();
+    void record(const SimVars* simVars, int64_t receiveTime);
+};
+
+long readFlightRecording(const char* filename, SimVars** samples, int64_t** times);
+
+#endif // _FLIGHTRECORDER_H_
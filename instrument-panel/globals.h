@@ -11,6 +11,13 @@
 
 class simvars;
 class knobs;
+class latency;
+class flightRecorder;
+class atlas;
+class scheduler;
+class preloader;
+class bitmapPack;
+class bitmapCache;
 
 struct globalVars
 {
@@ -32,10 +39,24 @@ struct globalVars
 
     simvars* simVars = NULL;
     knobs* hardwareKnobs = NULL;
+    latency* latencyStats = NULL;
+    flightRecorder* recorder = NULL;
+    atlas* spriteAtlas = NULL;
+    scheduler* frameScheduler = NULL;
+    preloader* bitmapPreloader = NULL;
+    bitmapPack* assetPack = NULL;
+    bitmapCache* sharedBitmaps = NULL;
 
     ALLEGRO_FONT* font = NULL;
     ALLEGRO_DISPLAY* display = NULL;
 
+    // Where the panel is drawn, i.e. the display's backbuffer or an
+    // offscreen memory bitmap when headless (no display or keyboard).
+    // Headless runs stop after frameLimit frames if set.
+    ALLEGRO_BITMAP* screen = NULL;
+    bool headless = false;
+    int frameLimit = 0;
+
     int displayX = 0;
     int displayY = 0;
     int displayWidth = 0;
@@ -45,7 +66,18 @@ struct globalVars
 
     char dataLinkHost[64] = "127.0.0.1";
     int dataLinkPort = 52020;
+    int dataLinkRate = 50;
+    char dataLinkMulticast[64] = "";
+    int dataLinkMulticastPort = 52021;
+    bool smoothing = true;
+    int smoothingDelayMs = 20;
+    int smoothingHorizonMs = 100;
+    char recordDir[256] = "";
     int startOnMonitor = 0;
+    bool directRender = false;
+    bool shaders = false;
+    int frameRate = 30;
+    int idleFrameRate = 2;
 
     int aircraft;
     char lastAircraft[256] = "\0";
@@ -54,11 +86,17 @@ struct globalVars
     bool arranging = false;
     bool simulating = false;
     bool dataLinked = false;
+
+    // Fixed steps to advance this frame and how far the frame is
+    // between the last two steps (see scheduler::advance).
+    int frameSteps = 0;
+    double stepFraction = 1;
     bool connected = false;
     bool active = true;
     bool electrics = false;
     bool externalControls = false;
     bool enableShadows = true;
+    bool atlasStale = false;
 };
 
 #endif // _GLOBALS_H_
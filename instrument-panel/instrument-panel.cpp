@@ -27,6 +27,11 @@
  *            connected.
  * s ........ Enable/disable shadows on instruments. Shadows give a more
  *            realistic 3D look.
+ * l ........ Show latency stats, i.e. how old the data on screen is, and
+ *            drawing stats (draw calls, texture binds and pixels filled
+ *            per frame).
+ * d ........ Switch between compositing each instrument into its own
+ *            bitmap and drawing instruments straight on screen.
  * Esc ...... Quit the program.
  * 
  * To make adjustments use the arrow keys. Up / down arrows select the
@@ -46,12 +51,15 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 #ifdef _WIN32
 // Windows only
 #include <Windows.h>
+#include <direct.h>
 #else
  // Raspberry Pi only
 #include "knobs.h"
+#include <sys/stat.h>
 #endif
 #include <list>
 #include <allegro5/allegro.h>
@@ -59,6 +67,14 @@
 #include <allegro5/allegro_font.h>
 #include "globals.h"
 #include "simvars.h"
+#include "latency.h"
+#include "flightRecorder.h"
+#include "atlas.h"
+#include "drawing.h"
+#include "scheduler.h"
+#include "preloader.h"
+#include "bitmapPack.h"
+#include "bitmapCache.h"
 
 // Instruments
 #include "adiLearjet.h"
@@ -82,18 +98,25 @@
 #include "nav.h"
 
 const bool HaveHardwareKnobs = true;
-const double FPS = 30.0;
 const bool Debug = false;
 
+// Offscreen resolution if headless and none given
+const int HeadlessWidth = 1920;
+const int HeadlessHeight = 1080;
+
+// Frame rate varies so messages are shown for a time
+const int64_t ErrorShowUs = 7000000;
+const int64_t VersionShowUs = 17000000;
+
 struct globalVars globals;
 
-ALLEGRO_TIMER* timer = NULL;
 ALLEGRO_EVENT_QUEUE* eventQueue = NULL;
 std::list<instrument*> instruments;
 char lastError[256] = "\0";
-int errorPersist;
+int64_t errorUntil;
 extern const char* versionString;
-int versionPersist = 500;
+int64_t versionUntil;
+long long fillFrames = 0;
 
 /// <summary>
 /// Display an error message
@@ -127,38 +150,66 @@ void fatalError(const char* msg)
 }
 
 /// <summary>
-/// Initialise Allegro etc.
+/// Record every sample received to a new file in the record directory
 /// </summary>
-void init()
+void startRecording()
 {
-    if (!al_init()) {
-        fatalError("Failed to initialise Allegro");
-    }
+#ifdef _WIN32
+    _mkdir(globals.recordDir);
+#else
+    mkdir(globals.recordDir, 0755);
+#endif
 
-    if (!al_init_font_addon()) {
-        fatalError("Failed to initialise font\n");
-    }
+    time_t now = time(NULL);
+    char timeStr[32];
+    strftime(timeStr, sizeof(timeStr), "%Y%m%d-%H%M%S", localtime(&now));
 
-    if (!al_init_image_addon()) {
-        fatalError("Failed to initialise image");
-    }
+    char filename[320];
+    sprintf(filename, "%s/flight-%s.svr", globals.recordDir, timeStr);
 
-    if (!al_install_keyboard()) {
-        fatalError("Failed to initialise keyboard");
-    }
-
-    if (!(timer = al_create_timer(1.0 / FPS))) {
-        fatalError("Failed to create timer");
+    globals.recorder = new flightRecorder(filename);
+    if (!globals.recorder->recording) {
+        delete globals.recorder;
+        globals.recorder = NULL;
     }
+}
 
-    if (!(eventQueue = al_create_event_queue())) {
-        fatalError("Failed to create event queue");
+/// <summary>
+/// Reads the command line. --headless[=WIDTHxHEIGHT] draws the panel into
+/// an offscreen bitmap instead of a display and --frames=N quits after N
+/// frames, e.g. to measure render cost on a server without a monitor.
+/// </summary>
+void parseArgs(int argc, char* argv[])
+{
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--headless") == 0) {
+            globals.headless = true;
+        }
+        else if (strncmp(argv[i], "--headless=", 11) == 0
+            && sscanf(argv[i] + 11, "%dx%d", &globals.displayWidth, &globals.displayHeight) == 2
+            && globals.displayWidth > 0 && globals.displayHeight > 0) {
+            globals.headless = true;
+        }
+        else if (strncmp(argv[i], "--frames=", 9) == 0 && atoi(argv[i] + 9) > 0) {
+            globals.frameLimit = atoi(argv[i] + 9);
+        }
+        else {
+            printf("Usage: instrument-panel [--headless[=WIDTHxHEIGHT]] [--frames=N]\n");
+            exit(1);
+        }
     }
 
-    if (!(globals.font = al_create_builtin_font())) {
-        fatalError("Failed to create font");
+    if (globals.headless && globals.displayWidth == 0) {
+        globals.displayWidth = HeadlessWidth;
+        globals.displayHeight = HeadlessHeight;
     }
+}
 
+/// <summary>
+/// Creates the fullscreen display the panel is drawn on
+/// </summary>
+void createDisplay()
+{
     al_set_new_window_title("Instrument Panel");
 
     // Use existing desktop resolution/refresh rate and force OpenGL ES 3
@@ -171,6 +222,11 @@ void init()
         flags = ALLEGRO_FULLSCREEN_WINDOW | ALLEGRO_FRAMELESS;
     }
 
+    if (globals.shaders) {
+        // Shaders need the programmable pipeline
+        flags |= ALLEGRO_PROGRAMMABLE_PIPELINE;
+    }
+
     al_set_new_display_flags(flags | ALLEGRO_OPENGL_3_0 | ALLEGRO_OPENGL_ES_PROFILE);
 
 #ifdef _WIN32
@@ -186,19 +242,94 @@ void init()
 
     globals.displayHeight = al_get_display_height(globals.display);
     globals.displayWidth = al_get_display_width(globals.display);
+    globals.screen = al_get_backbuffer(globals.display);
+
+    if (globals.shaders && !initShaders()) {
+        showError("Shaders not supported, using blender");
+    }
 
     al_hide_mouse_cursor(globals.display);
     al_inhibit_screensaver(true);
 
     al_register_event_source(eventQueue, al_get_keyboard_event_source());
-    al_register_event_source(eventQueue, al_get_timer_event_source(timer));
     al_register_event_source(eventQueue, al_get_display_event_source(globals.display));
+}
+
+/// <summary>
+/// Creates the bitmap the panel is drawn into when headless. Without a
+/// display every bitmap is a memory bitmap drawn by the CPU (and there
+/// are no shaders) but it runs anywhere.
+/// </summary>
+void createOffscreen()
+{
+    al_set_new_bitmap_flags(ALLEGRO_MEMORY_BITMAP);
+
+    if ((globals.screen = al_create_bitmap(globals.displayWidth, globals.displayHeight)) == NULL) {
+        fatalError("Failed to create offscreen bitmap");
+    }
+
+    al_set_target_bitmap(globals.screen);
+    printf("Headless: Drawing offscreen at %dx%d\n", globals.displayWidth, globals.displayHeight);
+}
+
+/// <summary>
+/// Initialise Allegro etc.
+/// </summary>
+void init()
+{
+    if (!al_init()) {
+        fatalError("Failed to initialise Allegro");
+    }
+
+    if (!al_init_font_addon()) {
+        fatalError("Failed to initialise font\n");
+    }
+
+    if (!al_init_image_addon()) {
+        fatalError("Failed to initialise image");
+    }
 
+    if (!globals.headless && !al_install_keyboard()) {
+        fatalError("Failed to initialise keyboard");
+    }
+
+    if (!(eventQueue = al_create_event_queue())) {
+        fatalError("Failed to create event queue");
+    }
+
+    if (!(globals.font = al_create_builtin_font())) {
+        fatalError("Failed to create font");
+    }
+
+    // Settings are needed before the display is created
     globals.simVars = new simvars();
+    globals.frameScheduler = new scheduler(eventQueue);
+
+    if (globals.headless) {
+        createOffscreen();
+    }
+    else {
+        createDisplay();
+    }
+
+    globals.latencyStats = new latency();
+    globals.spriteAtlas = new atlas();
+
+    // Use pre-decoded bitmaps if a pack has been built
+    char packPath[256];
+    strcpy(packPath, globals.BitmapDir);
+    strcat(packPath, PackFile);
+    globals.assetPack = new bitmapPack(packPath);
+    globals.sharedBitmaps = new bitmapCache();
+
+    if (globals.recordDir[0] != '\0') {
+        startRecording();
+    }
 
 #ifndef _WIN32
-    // Only have hardware knobs on Raspberry Pi
-    if (HaveHardwareKnobs) {
+    // Only have hardware knobs on Raspberry Pi, and never when headless
+    // as wiringPi exits on hardware it doesn't recognise.
+    if (HaveHardwareKnobs && !globals.headless) {
         globals.hardwareKnobs = new knobs();
     }
 #endif
@@ -215,8 +346,22 @@ void cleanup()
         instruments.pop_front();
     }
 
-    if (timer) {
-        al_destroy_timer(timer);
+    if (globals.spriteAtlas) {
+        delete globals.spriteAtlas;
+    }
+
+    if (globals.sharedBitmaps) {
+        delete globals.sharedBitmaps;
+    }
+
+    if (globals.assetPack) {
+        delete globals.assetPack;
+    }
+
+    destroyShaders();
+
+    if (globals.frameScheduler) {
+        delete globals.frameScheduler;
     }
 
     if (eventQueue) {
@@ -229,9 +374,11 @@ void cleanup()
 
     if (globals.display) {
         al_destroy_display(globals.display);
+        al_inhibit_screensaver(false);
+    }
+    else if (globals.screen) {
+        al_destroy_bitmap(globals.screen);
     }
-
-    al_inhibit_screensaver(false);
 }
 
 /// <summary>
@@ -260,12 +407,34 @@ void updateCommon()
 /// </summary>
 void doUpdate()
 {
+    globals.latencyStats->frameStarted();
+
+    // Pick up the latest sample from the data link (if any)
+    if (globals.simVars->acquire()) {
+        globals.latencyStats->sampleConsumed(globals.simVars->getSampleTimes());
+    }
+
+    // Estimate fast moving vars for when this frame will be shown
+    globals.simVars->smooth(latency::now() + globals.latencyStats->presentLead());
+
     // Update variables common to all instruments
     updateCommon();
 
-    // Update all instruments
+    // Update all instruments and step their needles to now
+    globals.frameScheduler->advance();
     for (auto const& instrument : instruments) {
         instrument->update();
+        for (int i = 0; i < globals.frameSteps; i++) {
+            instrument->step();
+        }
+    }
+
+    // Pack new sprites once instruments have stopped being resized
+    if (globals.atlasStale && !globals.arranging) {
+        globals.spriteAtlas->build(&instruments);
+
+        // Free sheets that are no longer used
+        globals.sharedBitmaps->trim();
     }
 }
 
@@ -370,10 +539,19 @@ void doRender()
     // Clear background
     al_clear_to_color(al_map_rgb(0, 0, 0));
 
-    // Draw all instruments
+    // Draw all instruments, batching draws from the same texture
+    useShaders(true);
+    holdDrawing(true);
     for (auto const& instrument : instruments) {
+        DrawCounts before = drawCounts();
         instrument->render();
+        DrawCounts after = drawCounts();
+        instrument->pixelsFilled += after.pixels - before.pixels;
+        instrument->pixelsScaled += after.scaledPixels - before.scaledPixels;
     }
+    holdDrawing(false);
+    fillFrames++;
+    useShaders(false);
 
     // Display any error message
     if (globals.error[0] != '\0') {
@@ -381,17 +559,14 @@ void doRender()
 
         if (strcmp(lastError, globals.error) == 0) {
             // Clear error message after a short delay
-            if (errorPersist > 0) {
-                errorPersist--;
-            }
-            else {
+            if (latency::now() > errorUntil) {
                 globals.error[0] = '\0';
                 lastError[0] = '\0';
             }
         }
         else {
             strcpy(lastError, globals.error);
-            errorPersist = 200;
+            errorUntil = latency::now() + ErrorShowUs;
         }
     }
     else if (globals.arranging || globals.simulating) {
@@ -399,14 +574,40 @@ void doRender()
         showMessage(al_map_rgb(0x10, 0x10, 0x50), text);
     }
 
-    if (versionPersist > 0) {
+    if (latency::now() < versionUntil) {
         int x, y, width;
         getMessagePos(&x, &y, &width);
         al_draw_text(globals.font, al_map_rgb(0xa0, 0xa0, 0xa0), x + width - 80, y + 45, 0, versionString);
-        versionPersist--;
     }
 }
 
+/// <summary>
+/// Shows the average pixels each instrument filled per frame since the
+/// stats were last shown, then starts again. Overdraw is pixels filled
+/// per pixel of the instrument and scaled is how many of those had to
+/// be resampled from a bitmap of a different size.
+/// </summary>
+void dumpFillStats(FILE* outfile)
+{
+    if (fillFrames == 0) {
+        return;
+    }
+
+    fprintf(outfile, "Fill per frame (%lld frames)\n", fillFrames);
+    fprintf(outfile, "  %-16s %8s %8s %8s\n", "", "kpixels", "overdraw", "kscaled");
+    for (auto const& instrument : instruments) {
+        double pixels = (double)instrument->pixelsFilled / fillFrames;
+        double area = (double)instrument->size * instrument->size;
+        fprintf(outfile, "  %-16s %8.1f %8.2f %8.1f\n", instrument->name, pixels / 1000, area > 0 ? pixels / area : 0,
+            (double)instrument->pixelsScaled / fillFrames / 1000);
+
+        instrument->pixelsFilled = 0;
+        instrument->pixelsScaled = 0;
+    }
+
+    fillFrames = 0;
+}
+
 /// <summary>
 /// Handle keypress
 /// </summary>
@@ -440,6 +641,18 @@ void doKeypress(ALLEGRO_EVENT *event)
         globals.enableShadows = !globals.enableShadows;
         break;
 
+    case ALLEGRO_KEY_D:
+        // Switch direct rendering on/off (saved in settings)
+        globals.directRender = !globals.directRender;
+        break;
+
+    case ALLEGRO_KEY_L:
+        // Show latency and drawing stats
+        globals.latencyStats->dump(stdout);
+        dumpDrawStats(stdout);
+        dumpFillStats(stdout);
+        break;
+
     case ALLEGRO_KEY_ESCAPE:
         // Quit program
         globals.quit = true;
@@ -537,16 +750,26 @@ void addInstruments()
 ///
 /// main
 ///
-int main()
+int main(int argc, char* argv[])
 {
+    parseArgs(argc, argv);
     init();
+    versionUntil = latency::now() + VersionShowUs;
 
-    for (int i = 0; i < globals.startOnMonitor; i++) {
+    for (int i = 0; i < globals.startOnMonitor && globals.display; i++) {
         switchMonitor();
     }
 
     addCommon();
+
+    // Decode instrument bitmaps in parallel before creating instruments
+    globals.bitmapPreloader = new preloader();
     addInstruments();
+    delete globals.bitmapPreloader;
+    globals.bitmapPreloader = NULL;
+
+    // Subscribe to the vars used by the enabled instruments
+    globals.simVars->startDataLink();
 
     // Use simulated values for initial defaults so that
     // instruments look normal if we can't connect yet.
@@ -555,19 +778,21 @@ int main()
     globals.simulating = false;
 
     bool redraw = true;
+    int frames = 0;
     ALLEGRO_EVENT event;
 
-    al_start_timer(timer);
+    globals.frameScheduler->start();
     while (!globals.quit) {
         al_wait_for_event(eventQueue, &event);
 
         switch (event.type) {
             case ALLEGRO_EVENT_TIMER:
-                doUpdate();
+            case scheduler::WakeEvent:
                 redraw = true;
                 break;
 
             case ALLEGRO_EVENT_KEY_DOWN:
+                globals.frameScheduler->wake();
                 doKeypress(&event);
                 break;
 
@@ -577,17 +802,45 @@ int main()
         }
 
         if (redraw && al_is_event_queue_empty(eventQueue) && !globals.quit) {
+            // Instruments catch up on any steps missed by a late frame
+            doUpdate();
             doRender();
-            al_flip_display();
+            globals.latencyStats->frameRendered();
+            if (globals.display) {
+                al_flip_display();
+            }
+            globals.latencyStats->frameFlipped();
+            drawFrameDone();
             redraw = false;
+
+            if (++frames == globals.frameLimit) {
+                globals.quit = true;
+            }
+
+            // Slow down or speed up for the next frame
+            globals.frameScheduler->update();
         }
     }
 
+    globals.latencyStats->dump(stdout);
+    delete globals.latencyStats;
+
+    if (globals.headless) {
+        // No keyboard to ask for them
+        dumpDrawStats(stdout);
+        dumpFillStats(stdout);
+    }
+
     // Settings get saved when simVars are destructed
     if (globals.simVars) {
         delete globals.simVars;
     }
 
+    // Data link has stopped so nothing more to record
+    if (globals.recorder) {
+        delete globals.recorder;
+    }
+
 #ifndef _WIN32
     if (globals.hardwareKnobs) {
         delete globals.hardwareKnobs;
@@ -1,7 +1,10 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include "instrument.h"
 #include "simvars.h"
+#include "bitmapCache.h"
+#include "latency.h"
 
 /// <summary>
 /// Default Constructor
@@ -9,6 +12,7 @@
 instrument::instrument()
 {
     bitmapCount = 0;
+    addState(&globals.enableShadows);
 }
 
 /// <summary>
@@ -19,6 +23,8 @@ instrument::instrument(int xPos, int yPos, int size)
     this->xPos = xPos;
     this->yPos = yPos;
     this->size = size;
+    liveSize = size;
+    addState(&globals.enableShadows);
 }
 
 /// <summary>
@@ -27,6 +33,10 @@ instrument::instrument(int xPos, int yPos, int size)
 instrument::~instrument()
 {
     destroyBitmaps();
+
+    for (int i = 0; i < keptCount; i++) {
+        globals.sharedBitmaps->release(keptBitmaps[i]);
+    }
 }
 
 /// <summary>
@@ -42,24 +52,26 @@ void instrument::setName(const char *name)
 }
 
 /// <summary>
-/// Load a bitmap from the bitmap directory
+/// Load a bitmap from the bitmap directory. The bitmap is shared with any
+/// other instrument that loads the same file so must not be drawn into.
 /// </summary>
 ALLEGRO_BITMAP *instrument::loadBitmap(const char* filename)
 {
-    char filepath[256];
-    strcpy(filepath, globals.BitmapDir);
-    strcat(filepath, filename);
-
-    ALLEGRO_BITMAP* bitmap = al_load_bitmap(filepath);
+    ALLEGRO_BITMAP* bitmap = globals.sharedBitmaps->acquire(filename);
     if (!bitmap) {
-        sprintf(globals.error, "Missing bitmap: %s", filepath);
+        sprintf(globals.error, "Missing bitmap: %s%s", globals.BitmapDir, filename);
         return NULL;
     }
 
     return bitmap;
 }
 
-void instrument::addBitmap(ALLEGRO_BITMAP* bitmap)
+/// <summary>
+/// Adds the next bitmap. bitmaps[1] is always the destination bitmap so
+/// is a target. Any other bitmap that render draws into must be added
+/// as a target too.
+/// </summary>
+void instrument::addBitmap(ALLEGRO_BITMAP* bitmap, bool isTarget)
 {
     if (bitmapCount >= MaxBitmaps) {
         strcpy(globals.error, "Maximum number of bitmaps per instrument exceeded");
@@ -67,39 +79,337 @@ void instrument::addBitmap(ALLEGRO_BITMAP* bitmap)
     }
 
     bitmaps[bitmapCount] = bitmap;
+    this->isTarget[bitmapCount] = isTarget || bitmapCount == 1;
     bitmapCount++;
+
+    // New sprites need packing into the atlas
+    globals.atlasStale = true;
+}
+
+/// <summary>
+/// Keeps a loaded bitmap for the life of the instrument, even while no
+/// bitmaps use it, so loading it again (e.g. on an aircraft change) is
+/// free.
+/// </summary>
+void instrument::keepBitmap(const char* filename)
+{
+    if (keptCount == MaxKeptBitmaps) {
+        strcpy(globals.error, "Maximum number of kept bitmaps per instrument exceeded");
+        return;
+    }
+
+    ALLEGRO_BITMAP* bitmap = loadBitmap(filename);
+    if (bitmap) {
+        keptBitmaps[keptCount++] = bitmap;
+    }
+}
+
+/// <summary>
+/// Renders a region of a loaded bitmap at the size render will draw it,
+/// for any layer that doesn't move with sim data (dial faces, bezels
+/// etc.) so render only has to blit it. The region is scaled down from a
+/// mipmapped copy which filters far better than scaling straight from
+/// the 800 pixel original every frame. Add the result as a bitmap.
+/// </summary>
+ALLEGRO_BITMAP* instrument::bakeLayer(ALLEGRO_BITMAP* source, int sx, int sy, int sw, int sh, int width, int height)
+{
+    ALLEGRO_BITMAP* layer = al_create_bitmap(width, height);
+    if (!layer) {
+        return NULL;
+    }
+
+    int op, src, dst;
+    al_get_blender(&op, &src, &dst);
+
+    // Copy exactly (including alpha)
+    al_set_blender(ALLEGRO_ADD, ALLEGRO_ONE, ALLEGRO_ZERO);
+
+    int flags = al_get_new_bitmap_flags();
+    al_set_new_bitmap_flags(flags | ALLEGRO_MIN_LINEAR | ALLEGRO_MAG_LINEAR | ALLEGRO_MIPMAP);
+    ALLEGRO_BITMAP* filtered = al_create_bitmap(sw, sh);
+    al_set_new_bitmap_flags(flags);
+
+    if (filtered) {
+        // Mipmaps are generated when the target changes
+        al_set_target_bitmap(filtered);
+        al_draw_bitmap_region(source, sx, sy, sw, sh, 0, 0, 0);
+        al_set_target_bitmap(layer);
+        al_draw_scaled_bitmap(filtered, 0, 0, sw, sh, 0, 0, width, height, 0);
+        al_destroy_bitmap(filtered);
+    }
+    else {
+        al_set_target_bitmap(layer);
+        al_draw_scaled_bitmap(source, sx, sy, sw, sh, 0, 0, width, height, 0);
+    }
+
+    al_set_blender(op, src, dst);
+    return layer;
+}
+
+/// <summary>
+/// Makes a variant (e.g. the fast plane dial) the current one, i.e. the
+/// one in bitmaps. resize builds each variant by selecting it and then
+/// adding its bitmaps. Once built, selecting a variant only swaps its
+/// bitmaps in so it can be done at any frame without rebuilding the
+/// atlas.
+/// </summary>
+void instrument::selectVariant(int num)
+{
+    if (num < 0 || num >= MaxVariants) {
+        strcpy(globals.error, "Maximum number of variants per instrument exceeded");
+        return;
+    }
+
+    if (num == variant) {
+        return;
+    }
+
+    BitmapSet* set = &variants[variant];
+    set->count = bitmapCount;
+    memcpy(set->bitmaps, bitmaps, sizeof(bitmaps));
+    memcpy(set->isTarget, isTarget, sizeof(isTarget));
+
+    set = &variants[num];
+    bitmapCount = set->count;
+    memcpy(bitmaps, set->bitmaps, sizeof(bitmaps));
+    memcpy(isTarget, set->isTarget, sizeof(isTarget));
+    *set = BitmapSet();
+
+    variant = num;
+    composited = false;
 }
 
 void instrument::destroyBitmaps()
 {
-    // Destroy all bitmaps
-    for (int i = 0; i < bitmapCount; i++) {
-        al_destroy_bitmap(bitmaps[i]);
+    // Destroy all bitmaps of every variant (loaded bitmaps are only released)
+    for (int i = 0; i < MaxVariants; i++) {
+        if (i != variant) {
+            releaseBitmaps(variants[i].bitmaps, variants[i].count);
+            variants[i].count = 0;
+        }
     }
 
+    releaseBitmaps(bitmaps, bitmapCount);
     bitmapCount = 0;
+    composited = false;
 
     if (dim) {
-        al_destroy_bitmap(dim);
+        globals.sharedBitmaps->release(dim);
         dim = NULL;
     }
 }
 
+void instrument::releaseBitmaps(ALLEGRO_BITMAP** bitmaps, int count)
+{
+    for (int i = 0; i < count; i++) {
+        if (!globals.sharedBitmaps->release(bitmaps[i])) {
+            al_destroy_bitmap(bitmaps[i]);
+        }
+        bitmaps[i] = NULL;
+    }
+}
+
+void instrument::addStateBytes(const void* var, int bytes)
+{
+    if (stateVarCount == MaxStateVars || stateBytes + bytes > MaxStateBytes) {
+        strcpy(globals.error, "Maximum visual state per instrument exceeded");
+        return;
+    }
+
+    stateVars[stateVarCount].var = var;
+    stateVars[stateVarCount].bytes = bytes;
+    stateVarCount++;
+    stateBytes += bytes;
+}
+
 /// <summary>
-/// Will dim the instrument when not connected, i.e. screensaver
+/// Returns true if the visual state has changed since bitmaps[1] was last
+/// composited, i.e. it needs to be drawn again. Otherwise the previous
+/// composite can be drawn on screen as it is.
 /// </summary>
-void instrument::dimInstrument()
+bool instrument::stateChanged()
+{
+    bool changed = !composited;
+    char* key = stateKey;
+
+    for (int i = 0; i < stateVarCount; i++) {
+        if (changed || memcmp(key, stateVars[i].var, stateVars[i].bytes) != 0) {
+            memcpy(key, stateVars[i].var, stateVars[i].bytes);
+            changed = true;
+        }
+        key += stateVars[i].bytes;
+    }
+
+    composited = true;
+    return changed;
+}
+
+/// <summary>
+/// Starts drawing the instrument at the stored position. Returns false if
+/// there is nothing to draw, i.e. the previous composite is still valid.
+/// </summary>
+bool instrument::beginRender()
+{
+    return beginRender(xPos, yPos, size, size);
+}
+
+/// <summary>
+/// Starts drawing the instrument into the given screen area. Normally the
+/// instrument is composited into bitmaps[1], which is only redrawn when
+/// the visual state changes. With Direct Render enabled everything is
+/// drawn straight onto the backbuffer instead, translated to the screen
+/// area and clipped to it, so no intermediate bitmap is needed.
+/// </summary>
+bool instrument::beginRender(int x, int y, int width, int height)
+{
+    renderX = x;
+    renderY = y;
+    renderWidth = width;
+    renderHeight = height;
+
+    drawingDirect = globals.directRender && !needsComposite;
+    if (!drawingDirect) {
+        if (!stateChanged()) {
+            return false;
+        }
+
+        setTarget(bitmaps[1]);
+        return true;
+    }
+
+    // Composite is out of date if we switch back
+    composited = false;
+
+    // Scaled about the instrument position while being resized
+    float scale = liveScale();
+    int screenX = xPos + (x - xPos) * scale;
+    int screenY = yPos + (y - yPos) * scale;
+
+    setTarget(globals.screen);
+    setClipping(screenX, screenY, width * scale, height * scale);
+
+    ALLEGRO_TRANSFORM transform;
+    al_identity_transform(&transform);
+    al_scale_transform(&transform, scale, scale);
+    al_translate_transform(&transform, screenX, screenY);
+    al_use_transform(&transform);
+
+    return true;
+}
+
+/// <summary>
+/// Sets the target back to where the instrument is being drawn after
+/// drawing into a scratch bitmap.
+/// </summary>
+void instrument::targetDest()
+{
+    if (drawingDirect) {
+        // Backbuffer keeps its own transform and clipping
+        setTarget(globals.screen);
+    }
+    else {
+        setTarget(bitmaps[1]);
+    }
+}
+
+/// <summary>
+/// Finishes drawing the instrument. A composite gets positioned on screen.
+/// If dimmed the shader darkens the composite as it is drawn, otherwise
+/// the instrument is darkened afterwards.
+/// </summary>
+void instrument::endRender(bool dimmed)
+{
+    setTarget(globals.screen);
+
+    if (drawingDirect) {
+        ALLEGRO_TRANSFORM transform;
+        al_identity_transform(&transform);
+        al_use_transform(&transform);
+
+        setClipping(0, 0, globals.displayWidth, globals.displayHeight);
+    }
+    else if (dimmed && haveShaders()) {
+        loadDim();
+        setBrightness(dimLevel);
+        drawComposite();
+        setBrightness(1);
+        return;
+    }
+    else {
+        drawComposite();
+    }
+
+    if (dimmed) {
+        dimInstrument();
+    }
+}
+
+void instrument::loadDim()
 {
     if (dim == NULL) {
         dim = loadBitmap("dim.png");
+        if (dim) {
+            dimLevel = al_get_pixel(dim, 0, 0).g;
+        }
     }
+}
+
+/// <summary>
+/// Will dim the instrument when not connected, i.e. screensaver
+/// </summary>
+void instrument::dimInstrument()
+{
+    loadDim();
+
+    // Multiply (shades of grey darken, white has no effect)
+    beginShadows();
+    drawScaledBitmap(dim, 0, 0, 8, 8, xPos, yPos, liveSize, liveSize, 0);
+    endShadows();
+}
 
-    // Set blender to multiply (shades of grey darken, white has no effect)
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
+/// <summary>
+/// Returns true if bitmaps must be rebuilt for a new size. While arranging
+/// a new size is shown by scaling the current bitmaps (see liveScale) and
+/// only rebuilt once it has stopped changing, so holding down a key to
+/// resize an instrument doesn't rebuild it on every frame.
+/// </summary>
+bool instrument::sizeChanged(int newSize)
+{
+    if (newSize != liveSize) {
+        liveSize = newSize;
+        liveSizeTime = latency::now();
+    }
 
-    // Add pointer shadow
-    al_draw_scaled_bitmap(dim, 0, 0, 8, 8, xPos, yPos, size, size, 0);
+    if (liveSize == size) {
+        return false;
+    }
+
+    return !globals.arranging || latency::now() - liveSizeTime >= ResizeSettleUs;
+}
+
+/// <summary>
+/// How much to scale the bitmaps built at size to show them at liveSize.
+/// </summary>
+float instrument::liveScale()
+{
+    if (size <= 0 || liveSize == size) {
+        return 1;
+    }
+
+    return (float)liveSize / size;
+}
+
+/// <summary>
+/// Draws the composite on screen, scaled if it is being resized.
+/// </summary>
+void instrument::drawComposite()
+{
+    float scale = liveScale();
+    if (scale == 1) {
+        drawBitmap(bitmaps[1], renderX, renderY, 0);
+        return;
+    }
 
-    // Restore normal blender
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+    drawScaledBitmap(bitmaps[1], 0, 0, renderWidth, renderHeight, xPos + (renderX - xPos) * scale,
+        yPos + (renderY - yPos) * scale, renderWidth * scale, renderHeight * scale, 0);
 }
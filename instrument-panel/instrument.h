@@ -1,45 +1,149 @@
 #ifndef _INSTRUMENT_H_
 #define _INSTRUMENT_H_
 
+#include <stdint.h>
 #include <allegro5/allegro.h>
 #include <list>
 #include "globals.h"
+#include "drawing.h"
 
 extern globalVars globals;
 
 // Set maximum number of bitmaps per instrument
 const int MaxBitmaps = 18;
 
+// Set maximum number of variants (e.g. slow and fast plane dials) per instrument
+const int MaxVariants = 3;
+
+// Set maximum number of loaded bitmaps an instrument can keep
+const int MaxKeptBitmaps = 4;
+
+// Set maximum size of the visual state per instrument
+const int MaxStateVars = 32;
+const int MaxStateBytes = 512;
+
 // Convert Allegro4 angle (256 = full circle) into radians
 const double AngleFactor = 2.0f * ALLEGRO_PI / 256.0f;
 const double DegreesToRadians = ALLEGRO_PI / 180.0f;
 
 class instrument
 {
+private:
+    struct BitmapSet {
+        int count = 0;
+        ALLEGRO_BITMAP* bitmaps[MaxBitmaps] = { NULL };
+        bool isTarget[MaxBitmaps] = { false };
+    };
+
+    struct StateVar {
+        const void* var;
+        int bytes;
+    };
+
+    // Visual state, i.e. every value that changes how the instrument
+    // looks, and a copy of it from when bitmaps[1] was last composited.
+    StateVar stateVars[MaxStateVars];
+    int stateVarCount = 0;
+    int stateBytes = 0;
+    char stateKey[MaxStateBytes];
+    bool composited = false;
+
+    // Screen area being drawn by render
+    bool drawingDirect = false;
+    int renderX = 0;
+    int renderY = 0;
+    int renderWidth = 0;
+    int renderHeight = 0;
+
+    // Brightness of dim.png
+    float dimLevel = 1;
+
+    // Size shown while arranging and when it last changed. Bitmaps are
+    // only rebuilt at this size once it stops changing, until then the
+    // instrument is scaled.
+    static const int64_t ResizeSettleUs = 500000;
+    int liveSize = 0;
+    int64_t liveSizeTime = 0;
+
+    // Loaded bitmaps held for the life of the instrument
+    ALLEGRO_BITMAP* keptBitmaps[MaxKeptBitmaps] = { NULL };
+    int keptCount = 0;
+
+    // Bitmaps of the variants not currently selected. resize builds every
+    // variant so their sprites are all in the atlas and selecting another
+    // only swaps bitmaps.
+    BitmapSet variants[MaxVariants];
+    int variant = 0;
+
+    void addStateBytes(const void* var, int bytes);
+    void releaseBitmaps(ALLEGRO_BITMAP** bitmaps, int count);
+    void loadDim();
+    void dimInstrument();
+    float liveScale();
+    void drawComposite();
+
 protected:
     int bitmapCount = 0;
     ALLEGRO_BITMAP* bitmaps[MaxBitmaps] = { NULL };
     ALLEGRO_BITMAP* dim = NULL;
 
+    // Bitmaps drawn into by render, i.e. bitmaps[1] and any scratch
+    // bitmaps. These can't share a texture with the sprites.
+    bool isTarget[MaxBitmaps] = { false };
+
+    // Set if the instrument must always be composited into bitmaps[1],
+    // even when drawing straight to the screen is enabled.
+    bool needsComposite = false;
+
+    // The atlas replaces sprites with sub-bitmaps of its pages
+    friend class atlas;
+
 public:
     char name[256];
     int xPos = 0;
     int yPos = 0;
     int size = 0;
 
+    // Pixels filled by render since the fill stats were last shown, and
+    // how many of those were resampled from a scaled source
+    long long pixelsFilled = 0;
+    long long pixelsScaled = 0;
+
     instrument();
     instrument(int xPos, int yPos, int size);
     ~instrument();
     void setName(const char* name);
-    void dimInstrument();
     virtual void resize() = 0;
     virtual void render() = 0;
     virtual void update() = 0;
+    virtual void step() {}
 
 protected:
     ALLEGRO_BITMAP* loadBitmap(const char* filename);
-    void addBitmap(ALLEGRO_BITMAP* bitmap);
+    void addBitmap(ALLEGRO_BITMAP* bitmap, bool isTarget = false);
     void destroyBitmaps();
+    void keepBitmap(const char* filename);
+    void selectVariant(int num);
+    ALLEGRO_BITMAP* bakeLayer(ALLEGRO_BITMAP* source, int sx, int sy, int sw, int sh, int width, int height);
+    bool stateChanged();
+    bool sizeChanged(int newSize);
+    bool beginRender();
+    bool beginRender(int x, int y, int width, int height);
+    void targetDest();
+    void endRender(bool dimmed);
+
+    /// <summary>
+    /// Returns a value part way between its last two steps, i.e. where a
+    /// needle moved by step should be drawn this frame.
+    /// </summary>
+    double interpolate(double prev, double next) { return prev + (next - prev) * globals.stepFraction; }
+
+    /// <summary>
+    /// Adds a value (calculated in update) that changes how the instrument
+    /// looks. The var must stay at the same address, i.e. be a member or
+    /// a global, and can be any plain type including a char array.
+    /// </summary>
+    template <typename T> void addState(const T* var) { addStateBytes(var, sizeof(T)); }
 };
 
 #endif // _INSTRUMENT_H
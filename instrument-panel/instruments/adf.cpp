@@ -16,6 +16,10 @@ adf::adf(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
     }
 #endif
 
+    // Values that change how the instrument looks
+    addState(&locAngle);
+    addState(&compassAngle);
+
     resize();
 }
 
@@ -54,12 +58,9 @@ void adf::resize()
     addBitmap(bmp);
 
     // 4 = Top
-    bmp = al_create_bitmap(size, size);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 1600, 0, 800, 800, 0, 0, size, size, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 1600, 0, 800, 800, size, size));
 
-    al_set_target_backbuffer(globals.display);
+    al_set_target_bitmap(globals.screen);
 }
 
 /// <summary>
@@ -72,27 +73,23 @@ void adf::render()
     }
 
     // Use normal blender
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
-
-    // Draw stuff into dest bitmap
-    al_set_target_bitmap(bitmaps[1]);
+    setBlender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
 
-    // Add locator
-    al_draw_scaled_rotated_bitmap(bitmaps[2], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, locAngle * DegreesToRadians, 0);
+    // Draw stuff into dest bitmap (only if something has changed) or
+    // straight on screen
+    if (beginRender()) {
+        // Add locator
+        drawScaledRotatedBitmap(bitmaps[2], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, locAngle * DegreesToRadians, 0);
 
-    // Add compass
-    al_draw_scaled_rotated_bitmap(bitmaps[3], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, compassAngle * DegreesToRadians, 0);
+        // Add compass
+        drawScaledRotatedBitmap(bitmaps[3], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, compassAngle * DegreesToRadians, 0);
 
-    // Add top
-    al_draw_bitmap(bitmaps[4], 0, 0, 0);
-
-    // Position dest bitmap on screen
-    al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
-
-    if (!globals.active) {
-        dimInstrument();
+        // Add top
+        drawBitmap(bitmaps[4], 0, 0, 0);
     }
+
+    // Position dest bitmap on screen (dimmed when not connected)
+    endRender(!globals.active);
 }
 
 /// <summary>
@@ -107,7 +104,7 @@ void adf::update()
     xPos = settings[0];
     yPos = settings[1];
 
-    if (size != settings[2]) {
+    if (sizeChanged(settings[2])) {
         size = settings[2];
         resize();
     }
@@ -120,7 +117,7 @@ void adf::update()
 #endif
 
     // Get latest FlightSim variables
-    SimVars* simVars = &globals.simVars->simVars;
+    SimVars* simVars = globals.simVars->simVars;
 
     // Calculate values
     locAngle = simVars->adfRadial;
@@ -153,7 +150,7 @@ void adf::updateKnobs()
         // Change ADF Card by knob movement amount (adjust for desired sensitivity)
         int adjust = (int)((prevVal - val) / 2) * 5;
         if (adjust != 0) {
-            double newVal = globals.simVars->simVars.adfCard + adjust;
+            double newVal = globals.simVars->simVars->adfCard + adjust;
 
             if (newVal < 0) {
                 newVal += 360;
@@ -16,6 +16,11 @@ adi::adi(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
     }
 #endif
 
+    // Values that change how the instrument looks
+    addState(&bankAngle);
+    addState(&pitchAngle);
+    addState(&currentAdiCal);
+
     resize();
 }
 
@@ -62,42 +67,24 @@ void adi::resize()
     addBitmap(bmp);
 
     // 6 = Rim shadow
-    bmp = al_create_bitmap(size, size);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 800, 1600, 800, 800, 0, 0, size, size, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 800, 1600, 800, 800, size, size));
 
     // 7 = Background
-    bmp = al_create_bitmap(size, size);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 0, 0, 800, 800, 0, 0, size, size, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 0, 0, 800, 800, size, size));
 
     // 8 = Outer casing
-    bmp = al_create_bitmap(size, size);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 0, 1600, 800, 800, 0, 0, size, size, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 0, 1600, 800, 800, size, size));
 
     // 9 = Outer pointer shadow
-    bmp = al_create_bitmap(200 * scaleFactor, 200 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 1100, 2400, 200, 200, 0, 0, 200 * scaleFactor, 200 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 1100, 2400, 200, 200, 200 * scaleFactor, 200 * scaleFactor));
 
     // 10 = Middle pointer
-    bmp = al_create_bitmap(size, 400 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 0, 3200, 800, 400, 0, 0, size, 400 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 0, 3200, 800, 400, size, 400 * scaleFactor));
 
     // 11 = Middle pointer shadow
-    bmp = al_create_bitmap(size, 400 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 800, 3200, 800, 400, 0, 0, size, 400 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 800, 3200, 800, 400, size, 400 * scaleFactor));
 
-    al_set_target_backbuffer(globals.display);
+    al_set_target_bitmap(globals.screen);
 }
 
 /// <summary>
@@ -105,65 +92,65 @@ void adi::resize()
 /// </summary>
 void adi::render()
 {
-    // Use normal blender
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
-
-    // Draw stuff into dest bitmap
-    al_set_target_bitmap(bitmaps[1]);
-
-    // Add back horizon and rotate
-    al_draw_scaled_rotated_bitmap(bitmaps[2], 400, 400, 400 * scaleFactor, (400 - pitchAngle * 5) * scaleFactor, scaleFactor, scaleFactor, bankAngle * DegreesToRadians, 0);
+    // Draw needles part way between their last two steps
+    pitchAngle = interpolate(prevPitch, stepPitch);
+    bankAngle = interpolate(prevBank, stepBank);
 
-    if (globals.enableShadows) {
-        // Set blender to multiply (shades of grey darken, white has no effect)
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
+    // Use normal blender
+    setBlender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
 
-        // Add horizon shadow
-        al_draw_scaled_rotated_bitmap(bitmaps[4], 400, 400, 415 * scaleFactor, (415 - pitchAngle * 5) * scaleFactor, scaleFactor, scaleFactor, bankAngle * DegreesToRadians, 0);
+    // Draw stuff into dest bitmap (only if something has changed) or
+    // straight on screen
+    if (beginRender()) {
+        // Add back horizon and rotate
+        drawScaledRotatedBitmap(bitmaps[2], 400, 400, 400 * scaleFactor, (400 - pitchAngle * 5) * scaleFactor, scaleFactor, scaleFactor, bankAngle * DegreesToRadians, 0);
 
-        // Restore normal blender
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
-    }
+        if (globals.enableShadows) {
+            // Multiply (shades of grey darken, white has no effect)
+            beginShadows();
 
-    // Add horizon
-    al_draw_scaled_rotated_bitmap(bitmaps[3], 400, 400, 400 * scaleFactor, (400 - pitchAngle * 5) * scaleFactor, scaleFactor, scaleFactor, bankAngle * DegreesToRadians, 0);
+            // Add horizon shadow
+            drawScaledRotatedBitmap(bitmaps[4], 400, 400, 415 * scaleFactor, (415 - pitchAngle * 5) * scaleFactor, scaleFactor, scaleFactor, bankAngle * DegreesToRadians, 0);
 
-    if (globals.enableShadows) {
-        // Set blender to multiply (shades of grey darken, white has no effect)
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
+            // Back to normal drawing
+            endShadows();
+        }
 
-        // Add rim shadow
-        al_draw_bitmap(bitmaps[6], 15 * scaleFactor, 15 * scaleFactor, 0);
+        // Add horizon
+        drawScaledRotatedBitmap(bitmaps[3], 400, 400, 400 * scaleFactor, (400 - pitchAngle * 5) * scaleFactor, scaleFactor, scaleFactor, bankAngle * DegreesToRadians, 0);
 
-        // Add outer pointer shadow
-        al_draw_bitmap(bitmaps[9], 315 * scaleFactor, 15 * scaleFactor, 0);
+        if (globals.enableShadows) {
+            // Multiply (shades of grey darken, white has no effect)
+            beginShadows();
 
-        // Add middle pointer shadow
-        al_draw_bitmap(bitmaps[11], 15 * scaleFactor, (355 - currentAdiCal * 10) * scaleFactor, 0);
+            // Add rim shadow
+            drawBitmap(bitmaps[6], 15 * scaleFactor, 15 * scaleFactor, 0);
 
-        // Restore normal blender
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
-    }
+            // Add outer pointer shadow
+            drawBitmap(bitmaps[9], 315 * scaleFactor, 15 * scaleFactor, 0);
 
-    // Add middle pointer
-    al_draw_bitmap(bitmaps[10], 0, (340 - currentAdiCal * 10) * scaleFactor, 0);
+            // Add middle pointer shadow
+            drawBitmap(bitmaps[11], 15 * scaleFactor, (355 - currentAdiCal * 10) * scaleFactor, 0);
 
-    // Add background
-    al_draw_bitmap(bitmaps[7], 0, 0, 0);
+            // Back to normal drawing
+            endShadows();
+        }
 
-    // Add rim
-    al_draw_scaled_rotated_bitmap(bitmaps[5], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, bankAngle * DegreesToRadians, 0);
+        // Add middle pointer
+        drawBitmap(bitmaps[10], 0, (340 - currentAdiCal * 10) * scaleFactor, 0);
 
-    // Add outer casing
-    al_draw_bitmap(bitmaps[8], 0, 0, 0);
+        // Add background
+        drawBitmap(bitmaps[7], 0, 0, 0);
 
-    // Position dest bitmap on screen
-    al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+        // Add rim
+        drawScaledRotatedBitmap(bitmaps[5], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, bankAngle * DegreesToRadians, 0);
 
-    if (!globals.active) {
-        dimInstrument();
+        // Add outer casing
+        drawBitmap(bitmaps[8], 0, 0, 0);
     }
+
+    // Position dest bitmap on screen (dimmed when not connected)
+    endRender(!globals.active);
 }
 
 /// <summary>
@@ -178,7 +165,7 @@ void adi::update()
     xPos = settings[0];
     yPos = settings[1];
 
-    if (size != settings[2]) {
+    if (sizeChanged(settings[2])) {
         size = settings[2];
         resize();
     }
@@ -189,65 +176,81 @@ void adi::update()
         updateKnobs();
     }
 #endif
+}
 
+/// <summary>
+/// Move needles one fixed step towards the latest FlightSim values
+/// </summary>
+void adi::step()
+{
     // Get latest FlightSim variables
-    SimVars *simVars = &globals.simVars->simVars;
+    SimVars *simVars = globals.simVars->simVars;
+
+    prevPitch = stepPitch;
+    prevBank = stepBank;
 
     // Calculate values
     double targetPitch = simVars->adiPitch;
-    double diff = abs(targetPitch - pitchAngle);
+    double diff = abs(targetPitch - stepPitch);
 
     if (diff > 80.0) {
-        if (pitchAngle < targetPitch) pitchAngle += 20.0; else pitchAngle -= 20.0;
+        if (stepPitch < targetPitch) stepPitch += 20.0; else stepPitch -= 20.0;
     }
     else if (diff > 40.0) {
-        if (pitchAngle < targetPitch) pitchAngle += 10.0; else pitchAngle -= 10.0;
+        if (stepPitch < targetPitch) stepPitch += 10.0; else stepPitch -= 10.0;
     }
     else if (diff > 20.0) {
-        if (pitchAngle < targetPitch) pitchAngle += 5.0; else pitchAngle -= 5.0;
+        if (stepPitch < targetPitch) stepPitch += 5.0; else stepPitch -= 5.0;
     }
     else if (diff > 10.0) {
-        if (pitchAngle < targetPitch) pitchAngle += 2.5; else pitchAngle -= 2.5;
+        if (stepPitch < targetPitch) stepPitch += 2.5; else stepPitch -= 2.5;
     }
     else if (diff > 5.0) {
-        if (pitchAngle < targetPitch) pitchAngle += 1.25; else pitchAngle -= 1.25;
+        if (stepPitch < targetPitch) stepPitch += 1.25; else stepPitch -= 1.25;
     }
     else if (diff > 0.625) {
-        if (pitchAngle < targetPitch) pitchAngle += 0.625; else pitchAngle -= 0.625;
+        if (stepPitch < targetPitch) stepPitch += 0.625; else stepPitch -= 0.625;
     }
     else {
-        pitchAngle = targetPitch;
+        stepPitch = targetPitch;
     }
 
     double targetBank = simVars->adiBank;
-    diff = abs(targetBank - bankAngle);
+    diff = abs(targetBank - stepBank);
 
     // Stop instrument flipping by 360 degrees
     if (diff > 300.0) {
-        if (bankAngle < targetBank) bankAngle += 360.0; else bankAngle -= 360.0;
-        diff = abs(targetBank - bankAngle);
+        if (stepBank < targetBank) {
+            stepBank += 360.0;
+            prevBank += 360.0;
+        }
+        else {
+            stepBank -= 360.0;
+            prevBank -= 360.0;
+        }
+        diff = abs(targetBank - stepBank);
     }
 
     if (diff > 80.0) {
-        if (bankAngle < targetBank) bankAngle += 20.0; else bankAngle -= 20.0;
+        if (stepBank < targetBank) stepBank += 20.0; else stepBank -= 20.0;
     }
     else if (diff > 40.0) {
-        if (bankAngle < targetBank) bankAngle += 10.0; else bankAngle -= 10.0;
+        if (stepBank < targetBank) stepBank += 10.0; else stepBank -= 10.0;
     }
     else if (diff > 20.0) {
-        if (bankAngle < targetBank) bankAngle += 5.0; else bankAngle -= 5.0;
+        if (stepBank < targetBank) stepBank += 5.0; else stepBank -= 5.0;
     }
     else if (diff > 10.0) {
-        if (bankAngle < targetBank) bankAngle += 2.5; else bankAngle -= 2.5;
+        if (stepBank < targetBank) stepBank += 2.5; else stepBank -= 2.5;
     }
     else if (diff > 5.0) {
-        if (bankAngle < targetBank) bankAngle += 1.25; else bankAngle -= 1.25;
+        if (stepBank < targetBank) stepBank += 1.25; else stepBank -= 1.25;
     }
     else if (diff > 0.625) {
-        if (bankAngle < targetBank) bankAngle += 0.625; else bankAngle -= 0.625;
+        if (stepBank < targetBank) stepBank += 0.625; else stepBank -= 0.625;
     }
     else {
-        bankAngle = targetBank;
+        stepBank = targetBank;
     }
 
     if (!globals.externalControls)
@@ -16,6 +16,16 @@ adiLearjet::adiLearjet(int xPos, int yPos, int size) : instrument(xPos, yPos, si
     }
 #endif
 
+    // Values that change how the instrument looks
+    addState(&bankAngle);
+    addState(&pitchAngle);
+    addState(&currentAdiCal);
+    addState(&globals.electrics);
+
+    // Wheel is drawn into a scratch bitmap first, so only switch targets
+    // when something has changed.
+    needsComposite = true;
+
     resize();
     time(&lastPowerTime);
 }
@@ -44,55 +54,45 @@ void adiLearjet::resize()
 
     // 2 = Wheel
     ALLEGRO_BITMAP* wheel = al_create_bitmap(506 * scaleFactor, 600 * scaleFactor);
-    addBitmap(wheel);
+    addBitmap(wheel, true);
 
     // 3 = Graduated transparency for wheel
-    ALLEGRO_BITMAP* trans = al_create_bitmap(506 * scaleFactor, 600 * scaleFactor);
-    al_set_target_bitmap(trans);
-    al_draw_scaled_bitmap(orig, 1311, 100, 506, 600, 0, 0, 506 * scaleFactor, 600 * scaleFactor, 0);
-    addBitmap(trans);
+    addBitmap(bakeLayer(orig, 1311, 100, 506, 600, 506 * scaleFactor, 600 * scaleFactor));
 
     // 4 = Horizon shadow
-    ALLEGRO_BITMAP* trans2 = al_create_bitmap(573 * scaleFactor, 110 * scaleFactor);
-    al_set_target_bitmap(trans2);
-    al_draw_scaled_bitmap(orig, 618, 1629, 573, 110, 0, 0, 573 * scaleFactor, 110 * scaleFactor, 0);
-    addBitmap(trans2);
+    addBitmap(bakeLayer(orig, 618, 1629, 573, 110, 573 * scaleFactor, 110 * scaleFactor));
 
     // 5 = Bezel shadow
-    ALLEGRO_BITMAP* trans3 = al_create_bitmap(652 * scaleFactor, 324 * scaleFactor);
-    al_set_target_bitmap(trans3);
-    al_draw_scaled_bitmap(orig, 509, 1794, 652, 324, 0, 0, 652 * scaleFactor, 324 * scaleFactor, 0);
-    addBitmap(trans3);
-
-    // 6 = OFF indicator
-    ALLEGRO_BITMAP* trans4 = al_create_bitmap(229 * scaleFactor, 389 * scaleFactor);
-    al_set_target_bitmap(trans4);
-    al_draw_scaled_bitmap(orig, 1524, 858, 229, 389, 0, 0, 229 * scaleFactor, 389 * scaleFactor, 0);
-    addBitmap(trans4);
-
-    // 7 = Roll pointer shadow
-    ALLEGRO_BITMAP* trans5 = al_create_bitmap(size, size);
-    addBitmap(trans5);
-
-    // 8 = Roll pointer sprite
-    ALLEGRO_BITMAP* pointer = al_create_bitmap(100 * scaleFactor, 600 * scaleFactor);
-    al_set_target_bitmap(pointer);
-    al_draw_scaled_bitmap(orig, 1297, 1388, 99, 599, 0, 0, 100 * scaleFactor, 600 * scaleFactor, 0);
-    addBitmap(pointer);
-
-    // 9 = Roll pointer shadow sprite
-    ALLEGRO_BITMAP* pointerShadow = al_create_bitmap(100 * scaleFactor, 600 * scaleFactor);
-    al_set_target_bitmap(pointerShadow);
-    al_draw_scaled_bitmap(orig, 1498, 1386, 99, 599, 0, 0, 100 * scaleFactor, 600 * scaleFactor, 0);
-    addBitmap(pointerShadow);
-
-    // 10 = Fill with background colour (takes 1 pixel of background and scales it)
+    addBitmap(bakeLayer(orig, 509, 1794, 652, 324, 652 * scaleFactor, 324 * scaleFactor));
+
+    // 6 = OFF indicator shadow
+    addBitmap(bakeLayer(orig, 1524, 858, 229, 389, 229 * scaleFactor, 389 * scaleFactor));
+
+    // 7 = Roll pointer sprite
+    addBitmap(bakeLayer(orig, 1297, 1388, 99, 599, 100 * scaleFactor, 600 * scaleFactor));
+
+    // 8 = Roll pointer shadow sprite
+    addBitmap(bakeLayer(orig, 1498, 1386, 99, 599, 100 * scaleFactor, 600 * scaleFactor));
+
+    // 9 = Fill with black (takes 1 pixel of background and scales it)
     ALLEGRO_BITMAP* bg = al_create_bitmap(size, size);
     al_set_target_bitmap(bg);
-    al_draw_scaled_bitmap(orig, 1267, 20, 1, 1, 0, 0, size, size, 0);
+    al_draw_scaled_bitmap(orig, 628, 850, 1, 1, 0, 0, size, size, 0);
     addBitmap(bg);
 
-    al_set_target_backbuffer(globals.display);
+    // 10 = Bezel
+    addBitmap(bakeLayer(orig, 507, 0, 798, 798, size, size));
+
+    // 11 = OFF indicator
+    addBitmap(bakeLayer(orig, 1236, 874, 213, 362, 213 * scaleFactor, 362 * scaleFactor));
+
+    // 12 = Wing pointer
+    addBitmap(bakeLayer(orig, 523, 820, 544, 92, 544 * scaleFactor, 92 * scaleFactor));
+
+    // 13 = Bits above and below the wheel
+    addBitmap(bakeLayer(orig, 507, 972, 506, 600, 506 * scaleFactor, 600 * scaleFactor));
+
+    al_set_target_bitmap(globals.screen);
 }
 
 /// <summary>
@@ -100,92 +100,84 @@ void adiLearjet::resize()
 /// </summary>
 void adiLearjet::render()
 {
+    // Draw needles part way between their last two steps
+    pitchAngle = interpolate(prevPitch, stepPitch);
+    bankAngle = interpolate(prevBank, stepBank);
+
     if (bitmaps[0] == NULL) {
         return;
     }
 
     // Use normal blender
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+    setBlender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+
+    // Draw stuff into dest bitmap (only if something has changed) or
+    // straight on screen
+    if (beginRender()) {
+        // Fill with black
+        drawBitmap(bitmaps[9], 0, 0, 0);
 
-    // Draw stuff into dest bitmap
-    al_set_target_bitmap(bitmaps[1]);
+        // Blit wheel into wheel sized bitmap
+        setTarget(bitmaps[2]);
+        drawScaledBitmap(bitmaps[0], 0, 900 - (pitchAngle * 5), 506, 600, 0, 0, 506 * scaleFactor, 600 * scaleFactor, 0);
 
-    // Fill with black
-    al_draw_scaled_bitmap(bitmaps[0], 628, 850, 1, 1, 0, 0, size, size, 0);
+        // Multiply (shades of grey darken, white has no effect)
+        beginShadows();
+        // Draw graduation to make wheel look round
+        drawBitmap(bitmaps[3], 0, 0, 0);
+        // Back to normal drawing
+        endShadows();
 
-    // Blit wheel into wheel sized bitmap
-    al_set_target_bitmap(bitmaps[2]);
-    al_draw_scaled_bitmap(bitmaps[0], 0, 900 - (pitchAngle * 5), 506, 600, 0, 0, 506 * scaleFactor, 600 * scaleFactor, 0);
+        // Draw bits above and below the wheel
+        drawBitmap(bitmaps[13], 0, 0, 0);
+        targetDest();
 
-    // Set blender to multiply (shades of grey darken, white has no effect)
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
-    // Draw graduation to make wheel look round
-    al_draw_bitmap(bitmaps[3], 0, 0, 0);
-    // Restore normal blender
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+        // Draw wheel
+        drawRotatedBitmap(bitmaps[2], 253 * scaleFactor, 300 * scaleFactor, 400 * scaleFactor, 400 * scaleFactor, bankAngle * 0.7111111 * DegreesToRadians, 0);
 
-    // Draw bits above and below the wheel
-    al_draw_scaled_bitmap(bitmaps[0], 507, 972, 506, 600, 0, 0, 506 * scaleFactor, 600 * scaleFactor, 0);
-    al_set_target_bitmap(bitmaps[1]);
+        if (globals.enableShadows)
+        {
+            // Draw shadows
+            // Multiply (shades of grey darken, white has no effect)
+            beginShadows();
 
-    // Draw wheel
-    al_draw_rotated_bitmap(bitmaps[2], 253 * scaleFactor, 300 * scaleFactor, 400 * scaleFactor, 400 * scaleFactor, bankAngle * 0.7111111 * DegreesToRadians, 0);
+            // Wing pointer shadow
+            drawBitmap(bitmaps[4], 186 * scaleFactor, (390 - (currentAdiCal * 10)) * scaleFactor, 0);
 
-    if (globals.enableShadows)
-    {
-        // Fill roll pointer shadow sprite with white
-        al_set_target_bitmap(bitmaps[7]);
-        al_draw_scaled_bitmap(bitmaps[0], 1484, 1387, 1, 1, 0, 0, size, size, 0);
+            // Bezel shadow
+            drawBitmap(bitmaps[5], 70 * scaleFactor, 90 * scaleFactor, 0);
 
-        // Draw roll_pointer shadow into trans5
-        al_draw_scaled_rotated_bitmap(bitmaps[9], 50 * scaleFactor, 300 * scaleFactor, 400 * scaleFactor, 415 * scaleFactor, .94, .94, bankAngle * 0.7111111 * DegreesToRadians, 0);
-        al_set_target_bitmap(bitmaps[1]);
+            if (!globals.electrics)
+            {
+                // OFF indicator shadow
+                drawBitmap(bitmaps[6], 18 * scaleFactor, 200 * scaleFactor, 0);
+            }
 
-        // Draw shadows
-        // Set blender to multiply (shades of grey darken, white has no effect)
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
+            // Roll pointer shadow
+            drawScaledRotatedBitmap(bitmaps[8], 50 * scaleFactor, 300 * scaleFactor, 400 * scaleFactor, 415 * scaleFactor, .94, .94, bankAngle * 0.7111111 * DegreesToRadians, 0);
 
-        // Wing pointer shadow
-        al_draw_bitmap(bitmaps[4], 186 * scaleFactor, (390 - (currentAdiCal * 10)) * scaleFactor, 0);
+            // Back to normal drawing
+            endShadows();
+        }
 
-        // Bezel shadow
-        al_draw_bitmap(bitmaps[5], 70 * scaleFactor, 90 * scaleFactor, 0);
+        // Draw Bezel
+        drawBitmap(bitmaps[10], 0, 0, 0);
 
         if (!globals.electrics)
         {
-            // OFF indicator shadow
-            al_draw_bitmap(bitmaps[6], 18 * scaleFactor, 200 * scaleFactor, 0);
+            // Draw OFF Indicator
+            drawBitmap(bitmaps[11], 15 * scaleFactor, 200 * scaleFactor, 0);
         }
 
-        // Roll pointer shadow
-        al_draw_bitmap(bitmaps[7], 0, 0, 0);
-
-        // Restore normal blender
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
-    }
-
-    // Draw Bezel
-    al_draw_scaled_bitmap(bitmaps[0], 507, 0, 798, 798, 0, 0, size, size, 0);
+        // Draw wing pointer Indicator
+        drawBitmap(bitmaps[12], 200 * scaleFactor, (380 - (currentAdiCal * 10)) * scaleFactor, 0);
 
-    if (!globals.electrics)
-    {
-        // Draw OFF Indicator
-        al_draw_scaled_bitmap(bitmaps[0], 1236, 874, 213, 362, 15 * scaleFactor, 200 * scaleFactor, 213 * scaleFactor, 362 * scaleFactor, 0);
+        // Draw roll pointer
+        drawScaledRotatedBitmap(bitmaps[7], 50 * scaleFactor, 300 * scaleFactor, 400 * scaleFactor, 400 * scaleFactor, .94, .94, bankAngle * 0.7111111 * DegreesToRadians, 0);
     }
 
-    // Draw wing pointer Indicator
-    al_draw_scaled_bitmap(bitmaps[0], 523, 820, 544, 92, 200 * scaleFactor, (380 - (currentAdiCal * 10)) * scaleFactor, 544 * scaleFactor, 92 * scaleFactor, 0);
-
-    // Draw roll pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[8], 50 * scaleFactor, 300 * scaleFactor, 400 * scaleFactor, 400 * scaleFactor, .94, .94, bankAngle * 0.7111111 * DegreesToRadians, 0);
-
-    // Position dest bitmap on screen
-    al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
-
-    if (!globals.active) {
-        dimInstrument();
-    }
+    // Position dest bitmap on screen (dimmed when not connected)
+    endRender(!globals.active);
 }
 
 /// <summary>
@@ -200,7 +192,7 @@ void adiLearjet::update()
     xPos = settings[0];
     yPos = settings[1];
 
-    if (size != settings[2]) {
+    if (sizeChanged(settings[2])) {
         size = settings[2];
         resize();
     }
@@ -211,9 +203,18 @@ void adiLearjet::update()
         updateKnobs();
     }
 #endif
+}
 
+/// <summary>
+/// Move needles one fixed step towards the latest FlightSim values
+/// </summary>
+void adiLearjet::step()
+{
     // Get latest FlightSim variables
-    SimVars* simVars = &globals.simVars->simVars;
+    SimVars* simVars = globals.simVars->simVars;
+
+    prevPitch = stepPitch;
+    prevBank = stepBank;
 
     // Calculate values
 
@@ -240,14 +241,14 @@ void adiLearjet::update()
     {
         if (failCount++ <= 200)
         {
-            if (pitchAngle < 90)
+            if (stepPitch < 90)
             {
-                pitchAngle += 0.03;
+                stepPitch += 0.03;
             }
 
-            if (bankAngle < 180)
+            if (stepBank < 180)
             {
-                bankAngle += 0.3;
+                stepBank += 0.3;
             }
         }
         else
@@ -258,59 +259,66 @@ void adiLearjet::update()
     else
     {
         double targetPitch = simVars->adiPitch;
-        double diff = abs(targetPitch - pitchAngle);
+        double diff = abs(targetPitch - stepPitch);
 
         if (diff > 80.0) {
-            if (pitchAngle < targetPitch) pitchAngle += 20.0; else pitchAngle -= 20.0;
+            if (stepPitch < targetPitch) stepPitch += 20.0; else stepPitch -= 20.0;
         }
         else if (diff > 40.0) {
-            if (pitchAngle < targetPitch) pitchAngle += 10.0; else pitchAngle -= 10.0;
+            if (stepPitch < targetPitch) stepPitch += 10.0; else stepPitch -= 10.0;
         }
         else if (diff > 20.0) {
-            if (pitchAngle < targetPitch) pitchAngle += 5.0; else pitchAngle -= 5.0;
+            if (stepPitch < targetPitch) stepPitch += 5.0; else stepPitch -= 5.0;
         }
         else if (diff > 10.0) {
-            if (pitchAngle < targetPitch) pitchAngle += 2.5; else pitchAngle -= 2.5;
+            if (stepPitch < targetPitch) stepPitch += 2.5; else stepPitch -= 2.5;
         }
         else if (diff > 5.0) {
-            if (pitchAngle < targetPitch) pitchAngle += 1.25; else pitchAngle -= 1.25;
+            if (stepPitch < targetPitch) stepPitch += 1.25; else stepPitch -= 1.25;
         }
         else if (diff > 0.625) {
-            if (pitchAngle < targetPitch) pitchAngle += 0.625; else pitchAngle -= 0.625;
+            if (stepPitch < targetPitch) stepPitch += 0.625; else stepPitch -= 0.625;
         }
         else {
-            pitchAngle = targetPitch;
+            stepPitch = targetPitch;
         }
 
         double targetBank = simVars->adiBank;
-        diff = abs(targetBank - bankAngle);
+        diff = abs(targetBank - stepBank);
 
         // Stop instrument flipping by 360 degrees
         if (diff > 300.0) {
-            if (bankAngle < targetBank) bankAngle += 360.0; else bankAngle -= 360.0;
-            diff = abs(targetBank - bankAngle);
+            if (stepBank < targetBank) {
+                stepBank += 360.0;
+                prevBank += 360.0;
+            }
+            else {
+                stepBank -= 360.0;
+                prevBank -= 360.0;
+            }
+            diff = abs(targetBank - stepBank);
         }
 
         if (diff > 80.0) {
-            if (bankAngle < targetBank) bankAngle += 20.0; else bankAngle -= 20.0;
+            if (stepBank < targetBank) stepBank += 20.0; else stepBank -= 20.0;
         }
         else if (diff > 40.0) {
-            if (bankAngle < targetBank) bankAngle += 10.0; else bankAngle -= 10.0;
+            if (stepBank < targetBank) stepBank += 10.0; else stepBank -= 10.0;
         }
         else if (diff > 20.0) {
-            if (bankAngle < targetBank) bankAngle += 5.0; else bankAngle -= 5.0;
+            if (stepBank < targetBank) stepBank += 5.0; else stepBank -= 5.0;
         }
         else if (diff > 10.0) {
-            if (bankAngle < targetBank) bankAngle += 2.5; else bankAngle -= 2.5;
+            if (stepBank < targetBank) stepBank += 2.5; else stepBank -= 2.5;
         }
         else if (diff > 5.0) {
-            if (bankAngle < targetBank) bankAngle += 1.25; else bankAngle -= 1.25;
+            if (stepBank < targetBank) stepBank += 1.25; else stepBank -= 1.25;
         }
         else if (diff > 0.625) {
-            if (bankAngle < targetBank) bankAngle += 0.625; else bankAngle -= 0.625;
+            if (stepBank < targetBank) stepBank += 0.625; else stepBank -= 0.625;
         }
         else {
-            bankAngle = targetBank;
+            stepBank = targetBank;
         }
 
         if (!globals.externalControls)
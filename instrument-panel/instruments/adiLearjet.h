@@ -11,6 +11,10 @@ private:
     // Instrument values (calculated from variables and needed to draw the instrument)
     double bankAngle = 0;
     double pitchAngle = 0;
+    double stepBank = 0;
+    double stepPitch = 0;
+    double prevBank = 0;
+    double prevPitch = 0;
     int adiCal = 0;
     int currentAdiCal = 0;
     int gyroSpinTime = 0;
@@ -24,6 +28,7 @@ public:
     adiLearjet(int xPos, int yPos, int size);
     void render();
     void update();
+    void step();
 
 private:
     void resize();
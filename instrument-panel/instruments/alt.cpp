@@ -16,6 +16,15 @@ alt::alt(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
     }
 #endif
 
+    // Values that change how the instrument looks
+    addState(&inhg);
+    addState(&mb);
+    addState(&altitude);
+
+    // Keep both sheets loaded so a resize never has to decode them again
+    keepBitmap("alt.png");
+    keepBitmap("alt-fast.png");
+
     resize();
 }
 
@@ -25,13 +34,22 @@ alt::alt(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 void alt::resize()
 {
     destroyBitmaps();
-    loadedAircraft = globals.aircraft;
 
-    if (globals.simVars->simVars.cruiseSpeed >= globals.FastPlaneSpeed) {
-        resizeFast();
-        return;
-    }
+    // Build both dials so an aircraft change only has to select one
+    selectVariant(FastDial);
+    resizeFast();
+
+    selectVariant(SlowDial);
+    resizeSlow();
 
+    selectVariant(fastPlane ? FastDial : SlowDial);
+}
+
+/// <summary>
+/// Builds the bitmaps for slower planes.
+/// </summary>
+void alt::resizeSlow()
+{
     // Create bitmaps scaled to correct size (original size is 800)
     scaleFactor = size / 800.0f;
 
@@ -78,30 +96,18 @@ void alt::resize()
     addBitmap(bmp);
 
     // 7 = Inner hole shadow
-    bmp = al_create_bitmap(200 * scaleFactor, 200 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 1700, 0, 200, 200, 0, 0, 200 * scaleFactor, 200 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 1700, 0, 200, 200, 200 * scaleFactor, 200 * scaleFactor));
 
     // 8 = Outer hole shadow
-    bmp = al_create_bitmap(200 * scaleFactor, 200 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 1700, 200, 200, 200, 0, 0, 200 * scaleFactor, 200 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 1700, 200, 200, 200, 200 * scaleFactor, 200 * scaleFactor));
 
     // 9 = Pointer hole shadow
-    bmp = al_create_bitmap(200, 200);
-    al_set_target_bitmap(bmp);
-    al_draw_bitmap_region(orig, 1700, 400, 200, 200, 0, 0, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 1700, 400, 200, 200, 200 * scaleFactor, 200 * scaleFactor));
 
     // 10 = Main dial
-    bmp = al_create_bitmap(size, size);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 0, 0, 800, 800, 0, 0, size, size, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 0, 0, 800, 800, size, size));
 
-    al_set_target_backbuffer(globals.display);
+    al_set_target_bitmap(globals.screen);
 }
 
 /// <summary>
@@ -126,36 +132,47 @@ void alt::resizeFast()
     addBitmap(dest);
 
     // 2 = Graduated transparency for altitude reels
-    ALLEGRO_BITMAP* trans = al_create_bitmap(78 * scaleFactor, 393 * scaleFactor);
-    addBitmap(trans);
+    addBitmap(bakeLayer(orig, 289, 0, 262, 254, 78 * scaleFactor, 393 * scaleFactor));
 
     // 3 = Graduated transparency for pressure reels
-    ALLEGRO_BITMAP* trans2 = al_create_bitmap(45 * scaleFactor, 162 * scaleFactor);
-    addBitmap(trans2);
+    addBitmap(bakeLayer(orig, 289, 0, 262, 254, 45 * scaleFactor, 162 * scaleFactor));
 
-    // 4 = Shadow background
-    ALLEGRO_BITMAP* shadowBackground = al_create_bitmap(800 * scaleFactor, 800 * scaleFactor);
-    addBitmap(shadowBackground);
+    // 4 = Shadow sprite
+    addBitmap(bakeLayer(orig, 192, 649, 43, 562, 43 * scaleFactor, 562 * scaleFactor));
 
-    // 5 = Shadow sprite
-    ALLEGRO_BITMAP* shadow = al_create_bitmap(43 * scaleFactor, 562 * scaleFactor);
-    al_set_target_bitmap(shadow);
-    al_draw_scaled_bitmap(orig, 192, 649, 43, 562, 0, 0, 43 * scaleFactor, 562 * scaleFactor, 0);
-    addBitmap(shadow);
-
-    // 6 = Fill with background colour (takes 1 pixel of background and scales it)
+    // 5 = Fill with black (takes 1 pixel of background and scales it)
     ALLEGRO_BITMAP* bg = al_create_bitmap(size, size);
     al_set_target_bitmap(bg);
-    al_draw_scaled_bitmap(orig, 75, 61, 1, 1, 0, 0, size, size, 0);
+    al_draw_scaled_bitmap(orig, 240, 312, 1, 1, 0, 0, size, size, 0);
     addBitmap(bg);
 
-    // 7 = Pointer sprite
+    // 6 = Pointer sprite
     ALLEGRO_BITMAP* pointer = al_create_bitmap(43, 562);
     al_set_target_bitmap(pointer);
     al_draw_bitmap_region(orig, 148, 649, 43, 562, 0, 0, 0);
     addBitmap(pointer);
 
-    al_set_target_backbuffer(globals.display);
+    // 7 = Electrics on/off
+    addBitmap(bakeLayer(orig, 194, 0, 95, 31, 98 * scaleFactor, 33 * scaleFactor));
+
+    // 8 = Dial
+    addBitmap(bakeLayer(orig, 240, 312, 800, 800, size, size));
+
+    // 9 = Pressure reel digits (4 reels tall so any digit can be shown)
+    int reelWidth = 45 * scaleFactor;
+    int reelHeight = 162 * scaleFactor;
+    addBitmap(bakeLayer(orig, 148, 0, 45, 648, reelWidth, reelHeight * 4));
+
+    // 10 = First altitude reel digits
+    reelWidth = 78 * scaleFactor;
+    reelHeight = 393 * scaleFactor;
+    int stripHeight = ReelStripHeight * reelHeight / 393.0f;
+    addBitmap(bakeLayer(orig, 0, 0, 73, ReelStripHeight, reelWidth, stripHeight));
+
+    // 11 = Other altitude reel digits
+    addBitmap(bakeLayer(orig, 74, 0, 73, ReelStripHeight, reelWidth, stripHeight));
+
+    al_set_target_bitmap(globals.screen);
 }
 
 /// <summary>
@@ -163,80 +180,79 @@ void alt::resizeFast()
 /// </summary>
 void alt::render()
 {
-    if (bitmaps[0] == NULL || loadedAircraft != globals.aircraft) {
+    // Draw needles part way between their last two steps
+    altitude = interpolate(prevAltitude, stepAltitude);
+
+    if (bitmaps[0] == NULL) {
         return;
     }
 
-    if (globals.simVars->simVars.cruiseSpeed >= globals.FastPlaneSpeed) {
+    if (fastPlane) {
         renderFast();
         return;
     }
 
     // Use normal blender
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
-
-    // Draw stuff into dest bitmap
-    al_set_target_bitmap(bitmaps[1]);
-
-    // Add outer scale (inches of mercury) and rotate
-    // 29.5 = 0 radians
-    angle = (29.5f - inhg) * 1.8f;
-    al_draw_scaled_rotated_bitmap(bitmaps[2], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle, 0);
-
-    // Add inner scale (millibars) and rotate
-    // 1000 = 0 radians
-    angle = (1000.0f - mb) * 0.0525f;
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_INVERSE_DEST_COLOR, ALLEGRO_ONE);
-    al_draw_scaled_rotated_bitmap(bitmaps[3], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle, 0);
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
-
-    if (globals.enableShadows) {
-        // Set blender to multiply (shades of grey darken, white has no effect)
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
+    setBlender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+
+    // Draw stuff into dest bitmap (only if something has changed) or
+    // straight on screen
+    if (beginRender()) {
+        // Add outer scale (inches of mercury) and rotate
+        // 29.5 = 0 radians
+        angle = (29.5f - inhg) * 1.8f;
+        drawScaledRotatedBitmap(bitmaps[2], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle, 0);
+
+        // Add inner scale (millibars) and rotate
+        // 1000 = 0 radians
+        angle = (1000.0f - mb) * 0.0525f;
+        setBlender(ALLEGRO_ADD, ALLEGRO_INVERSE_DEST_COLOR, ALLEGRO_ONE);
+        drawScaledRotatedBitmap(bitmaps[3], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle, 0);
+        setBlender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+
+        if (globals.enableShadows) {
+            // Multiply (shades of grey darken, white has no effect)
+            beginShadows();
+
+            // Add inner hole shadow
+            drawBitmapRegion(bitmaps[7], 0, 0, 200, 200, 60 * scaleFactor, 310 * scaleFactor, 0);
+
+            // Add outer hole Shadow
+            drawBitmapRegion(bitmaps[8], 0, 0, 200, 200, 610 * scaleFactor, 310 * scaleFactor, 0);
+
+            // Back to normal drawing
+            endShadows();
+        }
 
-        // Add inner hole shadow
-        al_draw_bitmap_region(bitmaps[7], 0, 0, 200, 200, 60 * scaleFactor, 310 * scaleFactor, 0);
+        // Add main dial
+        drawBitmap(bitmaps[10], 0, 0, 0);
 
-        // Add outer hole Shadow
-        al_draw_bitmap_region(bitmaps[8], 0, 0, 200, 200, 610 * scaleFactor, 310 * scaleFactor, 0);
+        if (globals.enableShadows) {
+            // Multiply (shades of grey darken, white has no effect)
+            beginShadows();
 
-        // Restore normal blender
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
-    }
+            // Add pointer hole shadow
+            drawBitmap(bitmaps[9], 310 * scaleFactor, 410 * scaleFactor, 0);
 
-    // Add main dial
-    al_draw_bitmap(bitmaps[10], 0, 0, 0);
+            // Back to normal drawing
+            endShadows();
+        }
 
-    if (globals.enableShadows) {
-        // Set blender to multiply (shades of grey darken, white has no effect)
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
+        // Add 1000ft pointer
+        // 0 = 0 radians
+        angle = altitude * 0.0062832f;
+        drawScaledRotatedBitmap(bitmaps[4], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle / 100, 0);
 
-        // Add pointer hole shadow
-        al_draw_scaled_bitmap(bitmaps[9], 0, 0, 200, 200, 310 * scaleFactor, 410 * scaleFactor, 200 * scaleFactor, 200 * scaleFactor, 0);
+        // Add 100ft pointer
+        // 0 = 0 radians
+        drawScaledRotatedBitmap(bitmaps[5], 50, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle / 10, 0);
 
-        // Restore normal blender
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+        // Add 1ft pointer
+        drawScaledRotatedBitmap(bitmaps[6], 50, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle, 0);
     }
 
-    // Add 1000ft pointer
-    // 0 = 0 radians
-    angle = altitude * 0.0062832f;
-    al_draw_scaled_rotated_bitmap(bitmaps[4], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle / 100, 0);
-
-    // Add 100ft pointer
-    // 0 = 0 radians
-    al_draw_scaled_rotated_bitmap(bitmaps[5], 50, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle / 10, 0);
-
-    // Add 1ft pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[6], 50, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle, 0);
-
-    // Position dest bitmap on screen
-    al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
-
-    if (!globals.active) {
-        dimInstrument();
-    }
+    // Position dest bitmap on screen (dimmed when not connected)
+    endRender(!globals.active);
 }
 
 /// <summary>
@@ -245,108 +261,82 @@ void alt::render()
 void alt::renderFast()
 {
     // Use normal blender
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
-
-    // Draw stuff into dest bitmap
-    al_set_target_bitmap(bitmaps[1]);
-
-    // Fill with black
-    al_draw_scaled_bitmap(bitmaps[0], 240, 312, 1, 1, 0, 0, size, size, 0);
-
-    // Copy graduated pattern artwork into trans2 bitmap for the small digits
-    int destWidth = 45 * scaleFactor;
-    int destHeight = 162 * scaleFactor;
-    al_set_target_bitmap(bitmaps[3]);
-    al_draw_scaled_bitmap(bitmaps[0], 289, 0, 262, 254, 0, 0, destWidth, destHeight, 0);
-    al_set_target_bitmap(bitmaps[1]);
-
-    // Copy graduated pattern artwork into trans bitmap
-    al_set_target_bitmap(bitmaps[2]);
-    al_draw_scaled_bitmap(bitmaps[0], 289, 0, 262, 254, 0, 0, 78 * scaleFactor, 393 * scaleFactor, 0);
-    al_set_target_bitmap(bitmaps[1]);
-
-    // Add hPa Reels
-    int val = mb + 0.1;
-    addSmallNumber(157 * scaleFactor, val / 1000, (val % 1000) / 100, (val % 100) / 10, val % 10);
-
-    // Draw InHg Reels
-    val = (inhg * 100) + 0.1;
-    addSmallNumber(465 * scaleFactor, val / 1000, (val % 1000) / 100, (val % 100) / 10, val % 10);
-
-    // Draw Altitude reels
-    int offset = (int)(10 * altitude) % 100;
-    val = (altitude + 3) / 10;
-
-    int digit = val / 1000;
-    int yPos1 = 262 + 131 * (8 - digit);
-    if (val % 1000 == 999) {
-        yPos1 -= offset;
-    }
-
-    digit = (val % 1000) / 100;
-    int yPos2 = 262 + 131 * (8 - digit);
-    if (val % 100 == 99) {
-        yPos2 -= offset;
-    }
+    setBlender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+
+    // Draw stuff into dest bitmap (only if something has changed) or
+    // straight on screen
+    if (beginRender()) {
+        // Fill with black
+        drawBitmap(bitmaps[5], 0, 0, 0);
+
+        // Add hPa Reels
+        int val = mb + 0.1;
+        addSmallNumber(157 * scaleFactor, val / 1000, (val % 1000) / 100, (val % 100) / 10, val % 10);
+
+        // Draw InHg Reels
+        val = (inhg * 100) + 0.1;
+        addSmallNumber(465 * scaleFactor, val / 1000, (val % 1000) / 100, (val % 100) / 10, val % 10);
+
+        // Draw Altitude reels
+        int offset = (int)(10 * altitude) % 100;
+        val = (altitude + 3) / 10;
+
+        int digit = val / 1000;
+        int yPos1 = 262 + 131 * (8 - digit);
+        if (val % 1000 == 999) {
+            yPos1 -= offset;
+        }
 
-    digit = (val % 100) / 10;
-    int yPos3 = 262 + 131 * (8 - digit);
-    if (val % 10 == 9) {
-        yPos3 -= offset;
-    }
+        digit = (val % 1000) / 100;
+        int yPos2 = 262 + 131 * (8 - digit);
+        if (val % 100 == 99) {
+            yPos2 -= offset;
+        }
 
-    addLargeNumber(yPos1, yPos2, yPos3);
+        digit = (val % 100) / 10;
+        int yPos3 = 262 + 131 * (8 - digit);
+        if (val % 10 == 9) {
+            yPos3 -= offset;
+        }
 
-    // Set blender to multiply (shades of grey darken, white has no effect)
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
+        addLargeNumber(yPos1, yPos2, yPos3);
 
-    // hPa Reels overlay graduated transparencies
-    addSmallShadow(157 * scaleFactor);
+        // Multiply (shades of grey darken, white has no effect)
+        beginShadows();
 
-    // IN HG Reels overlay the graduated transparencies
-    addSmallShadow(465 * scaleFactor);
+        // hPa Reels overlay graduated transparencies
+        addSmallShadow(157 * scaleFactor);
 
-    // Altitutude Reels overlay the graduated transparencies
-    addLargeShadow();
+        // IN HG Reels overlay the graduated transparencies
+        addSmallShadow(465 * scaleFactor);
 
-    // Restore normal blender
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+        // Altitutude Reels overlay the graduated transparencies
+        addLargeShadow();
 
-    // Draw electrics on/off
-    al_draw_scaled_bitmap(bitmaps[0], 194, 0, 95, 31, 277 * scaleFactor, 681 * scaleFactor, 98 * scaleFactor, 33 * scaleFactor, 0);
+        // Back to normal drawing
+        endShadows();
 
-    // Display Dial
-    al_draw_scaled_bitmap(bitmaps[0], 240, 312, 800, 800, 0, 0, size, size, 0);
+        // Draw electrics on/off
+        drawBitmap(bitmaps[7], 277 * scaleFactor, 681 * scaleFactor, 0);
 
-    angle = (altitude - (int)(altitude / 100) * 100.0) * 3.6 * DegreesToRadians;
+        // Display Dial
+        drawBitmap(bitmaps[8], 0, 0, 0);
 
-    if (globals.enableShadows) {
-        // Fill shadow_background bitmap with white
-        al_set_target_bitmap(bitmaps[4]);
-        al_draw_scaled_bitmap(bitmaps[0], 192, 649, 1, 1, 0, 0, size, size, 0);
+        angle = (altitude - (int)(altitude / 100) * 100.0) * 3.6 * DegreesToRadians;
 
-        // Write shadow sprite to shadow background
-        al_draw_rotated_bitmap(bitmaps[5], 21 * scaleFactor, 322 * scaleFactor, 410 * scaleFactor, 420 * scaleFactor, angle, 0);
-        al_set_target_bitmap(bitmaps[1]);
+        if (globals.enableShadows) {
+            // Multiply rotated shadow sprite straight into dest
+            beginShadows();
+            drawRotatedBitmap(bitmaps[4], 21 * scaleFactor, 322 * scaleFactor, 410 * scaleFactor, 420 * scaleFactor, angle, 0);
+            endShadows();
+        }
 
-        // Draw shadow
-        // Set blender to multiply (shades of grey darken, white has no effect)
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
-        al_draw_bitmap(bitmaps[4], 0, 0, 0);
-        // Restore normal blender
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+        //Draw needle pointer at angle
+        drawScaledRotatedBitmap(bitmaps[6], 21, 322, size / 2, size / 2, scaleFactor, scaleFactor, angle, 0);
     }
 
-    //Draw needle pointer at angle
-    al_draw_scaled_rotated_bitmap(bitmaps[7], 21, 322, size / 2, size / 2, scaleFactor, scaleFactor, angle, 0);
-
-    // Position dest bitmap on screen
-    al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
-
-    if (!globals.active) {
-        dimInstrument();
-    }
+    // Position dest bitmap on screen (dimmed when not connected)
+    endRender(!globals.active);
 }
 
 void alt::addSmallNumber(int yPos, int digit1, int digit2, int digit3, int digit4)
@@ -354,18 +344,21 @@ void alt::addSmallNumber(int yPos, int digit1, int digit2, int digit3, int digit
     int destWidth = 45 * scaleFactor;
     int destHeight = 162 * scaleFactor;
 
-    al_draw_scaled_bitmap(bitmaps[0], 148, 54 * (9 - digit1), 45, 162, 486 * scaleFactor, yPos, destWidth, destHeight, 0);
-    al_draw_scaled_bitmap(bitmaps[0], 148, 54 * (9 - digit2), 45, 162, 532 * scaleFactor, yPos, destWidth, destHeight, 0);
-    al_draw_scaled_bitmap(bitmaps[0], 148, 54 * (9 - digit3), 45, 162, 578 * scaleFactor, yPos, destWidth, destHeight, 0);
-    al_draw_scaled_bitmap(bitmaps[0], 148, 54 * (9 - digit4), 45, 162, 624 * scaleFactor, yPos, destWidth, destHeight, 0);
+    // Each digit is a third of a reel
+    float digitHeight = destHeight / 3.0f;
+
+    drawBitmapRegion(bitmaps[9], 0, digitHeight * (9 - digit1), destWidth, destHeight, 486 * scaleFactor, yPos, 0);
+    drawBitmapRegion(bitmaps[9], 0, digitHeight * (9 - digit2), destWidth, destHeight, 532 * scaleFactor, yPos, 0);
+    drawBitmapRegion(bitmaps[9], 0, digitHeight * (9 - digit3), destWidth, destHeight, 578 * scaleFactor, yPos, 0);
+    drawBitmapRegion(bitmaps[9], 0, digitHeight * (9 - digit4), destWidth, destHeight, 624 * scaleFactor, yPos, 0);
 }
 
 void alt::addSmallShadow(int yPos)
 {
-    al_draw_bitmap(bitmaps[3], 486 * scaleFactor, yPos, 0);
-    al_draw_bitmap(bitmaps[3], 532 * scaleFactor, yPos, 0);
-    al_draw_bitmap(bitmaps[3], 578 * scaleFactor, yPos, 0);
-    al_draw_bitmap(bitmaps[3], 624 * scaleFactor, yPos, 0);
+    drawBitmap(bitmaps[3], 486 * scaleFactor, yPos, 0);
+    drawBitmap(bitmaps[3], 532 * scaleFactor, yPos, 0);
+    drawBitmap(bitmaps[3], 578 * scaleFactor, yPos, 0);
+    drawBitmap(bitmaps[3], 624 * scaleFactor, yPos, 0);
 }
 
 void alt::addLargeNumber(int yPos1, int yPos2, int yPos3)
@@ -374,18 +367,29 @@ void alt::addLargeNumber(int yPos1, int yPos2, int yPos3)
     int destWidth = 78 * scaleFactor;
     int destHeight = 393 * scaleFactor;
 
-    al_draw_scaled_bitmap(bitmaps[0], 0, yPos1, 73, 393, 70 * scaleFactor, destY, destWidth, destHeight, 0);
-    al_draw_scaled_bitmap(bitmaps[0], 74, yPos2, 73, 393, 151 * scaleFactor, destY, destWidth, destHeight, 0);
-    al_draw_scaled_bitmap(bitmaps[0], 74, yPos3, 73, 393, 233 * scaleFactor, destY, destWidth, destHeight, 0);
+    if (bitmaps[10] == NULL || bitmaps[11] == NULL) {
+        // Reels too tall for a texture so scale them every frame
+        drawScaledBitmap(bitmaps[0], 0, yPos1, 73, 393, 70 * scaleFactor, destY, destWidth, destHeight, 0);
+        drawScaledBitmap(bitmaps[0], 74, yPos2, 73, 393, 151 * scaleFactor, destY, destWidth, destHeight, 0);
+        drawScaledBitmap(bitmaps[0], 74, yPos3, 73, 393, 233 * scaleFactor, destY, destWidth, destHeight, 0);
+        return;
+    }
+
+    // Reel positions are in original pixels
+    float reelScale = destHeight / 393.0f;
+
+    drawBitmapRegion(bitmaps[10], 0, yPos1 * reelScale, destWidth, destHeight, 70 * scaleFactor, destY, 0);
+    drawBitmapRegion(bitmaps[11], 0, yPos2 * reelScale, destWidth, destHeight, 151 * scaleFactor, destY, 0);
+    drawBitmapRegion(bitmaps[11], 0, yPos3 * reelScale, destWidth, destHeight, 233 * scaleFactor, destY, 0);
 }
 
 void alt::addLargeShadow()
 {
     int destY = 202 * scaleFactor;
 
-    al_draw_bitmap(bitmaps[2], 70 * scaleFactor, destY, 0);
-    al_draw_bitmap(bitmaps[2], 151 * scaleFactor, destY, 0);
-    al_draw_bitmap(bitmaps[2], 233 * scaleFactor, destY, 0);
+    drawBitmap(bitmaps[2], 70 * scaleFactor, destY, 0);
+    drawBitmap(bitmaps[2], 151 * scaleFactor, destY, 0);
+    drawBitmap(bitmaps[2], 233 * scaleFactor, destY, 0);
 }
 
 /// <summary>
@@ -400,10 +404,19 @@ void alt::update()
     xPos = settings[0];
     yPos = settings[1];
 
-    if (size != settings[2] || loadedAircraft != globals.aircraft) {
+    // Only switch dials between frames so render always draws the
+    // bitmaps of the dial it was selected for, even if the aircraft
+    // changes mid frame. Both dials are already built so this can be
+    // done on any frame without a hitch.
+    fastPlane = globals.simVars->simVars->cruiseSpeed >= globals.FastPlaneSpeed;
+
+    if (sizeChanged(settings[2])) {
         size = settings[2];
         resize();
     }
+    else {
+        selectVariant(fastPlane ? FastDial : SlowDial);
+    }
 
 #ifndef _WIN32
     // Only have hardware knobs on Raspberry Pi
@@ -413,36 +426,47 @@ void alt::update()
 #endif
 
     // Get latest FlightSim variables
-    SimVars* simVars = &globals.simVars->simVars;
+    SimVars* simVars = globals.simVars->simVars;
 
     // Calculate values
 
     // Add altitude correction
     mb = simVars->altKollsman * 33.86389;
     inhg = simVars->altKollsman;
+}
+
+/// <summary>
+/// Move needles one fixed step towards the latest FlightSim values
+/// </summary>
+void alt::step()
+{
+    // Get latest FlightSim variables
+    SimVars* simVars = globals.simVars->simVars;
+
+    prevAltitude = stepAltitude;
 
-    double diff = abs(simVars->altAltitude - altitude);
+    double diff = abs(simVars->altAltitude - stepAltitude);
 
     if (diff > 500.0) {
-        if (altitude < simVars->altAltitude) altitude += 200.0; else altitude -= 200.0;
+        if (stepAltitude < simVars->altAltitude) stepAltitude += 200.0; else stepAltitude -= 200.0;
     }
     else if (diff > 100.0) {
-        if (altitude < simVars->altAltitude) altitude += 40.0; else altitude -= 40.0;
+        if (stepAltitude < simVars->altAltitude) stepAltitude += 40.0; else stepAltitude -= 40.0;
     }
     else if (diff > 50.0) {
-        if (altitude < simVars->altAltitude) altitude += 20.0; else altitude -= 20.0;
+        if (stepAltitude < simVars->altAltitude) stepAltitude += 20.0; else stepAltitude -= 20.0;
     }
     else if (diff > 10.0) {
-        if (altitude < simVars->altAltitude) altitude += 5.0; else altitude -= 5.0;
+        if (stepAltitude < simVars->altAltitude) stepAltitude += 5.0; else stepAltitude -= 5.0;
     }
     else if (diff > 5.0) {
-        if (altitude < simVars->altAltitude) altitude += 2.0; else altitude -= 2.0;
+        if (stepAltitude < simVars->altAltitude) stepAltitude += 2.0; else stepAltitude -= 2.0;
     }
     else if (diff > 1) {
-        if (altitude < simVars->altAltitude) altitude += 1.0; else altitude -= 1.0;
+        if (stepAltitude < simVars->altAltitude) stepAltitude += 1.0; else stepAltitude -= 1.0;
     }
     else {
-        altitude = simVars->altAltitude;
+        stepAltitude = simVars->altAltitude;
     }
 }
 
@@ -472,7 +496,7 @@ void alt::updateKnobs()
         // Change calibration by knob movement amount (adjust for desired sensitivity)
         double adjust = (int)((prevVal - val) / 2) * 0.01;
         if (adjust != 0) {
-            double newVal = (globals.simVars->simVars.altKollsman + adjust) * 541.82224;
+            double newVal = (globals.simVars->simVars->altKollsman + adjust) * 541.82224;
 
             globals.simVars->write(KEY_KOHLSMAN_SET, newVal);
             prevVal = val;
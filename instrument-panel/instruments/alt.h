@@ -6,14 +6,23 @@
 class alt : public instrument
 {
 private:
+    // Altitude reel digits run to the bottom of alt-fast.png
+    static const int ReelStripHeight = 1700;
+
+    // Variants (see selectVariant)
+    static const int SlowDial = 0;
+    static const int FastDial = 1;
+
     float scaleFactor;
 
     // Instrument values (caclulated from variables and needed to draw the instrument)
-    int loadedAircraft;
+    bool fastPlane = false;
     double mb;            // millibars
     double inhg;          // inches of mercury
     double angle;
     double altitude = 0;
+    double stepAltitude = 0;
+    double prevAltitude = 0;
 
     // Hardware knobs
     int calKnob = -1;
@@ -23,9 +32,11 @@ public:
     alt(int xPos, int yPos, int size);
     void render();
     void update();
+    void step();
 
 private:
     void resize();
+    void resizeSlow();
     void resizeFast();
     void renderFast();
     void addSmallNumber(int yPos, int digit1, int digit2, int digit3, int digit4);
@@ -6,10 +6,12 @@
 #include "annunciator.h"
 #include "simvars.h"
 #include "knobs.h"
+#include "latency.h"
 
 annunciator::annunciator(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
     setName("Annunciator");
+    addVars();
 
 #ifndef _WIN32
     // Only have hardware knobs on Raspberry Pi
@@ -18,6 +20,14 @@ annunciator::annunciator(int xPos, int yPos, int size) : instrument(xPos, yPos,
     }
 #endif
 
+    // Values that change how the instrument looks
+    addState(&globals.dataLinked);
+    addState(&globals.connected);
+    addState(&fuelWarning);
+    addState(&selection);
+    addState(&tailNumber);
+    addState(&callSign);
+
     resize();
 }
 
@@ -44,28 +54,16 @@ void annunciator::resize()
     addBitmap(bmp);
 
     // 2 = No warnings
-    bmp = al_create_bitmap(size, size / 4);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 0, 0, 800, 200, 0, 0, size, size / 4, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 0, 0, 800, 200, size, size / 4));
 
     // 3 = Low fuel
-    bmp = al_create_bitmap(size, size / 4);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 0, 200, 800, 200, 0, 0, size, size / 4, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 0, 200, 800, 200, size, size / 4));
 
     // 4 = No data link
-    bmp = al_create_bitmap(size, size / 4);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 0, 400, 800, 200, 0, 0, size, size / 4, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 0, 400, 800, 200, size, size / 4));
 
     // 5 = Not connected
-    bmp = al_create_bitmap(size, size / 4);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 0, 600, 800, 200, 0, 0, size, size / 4, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 0, 600, 800, 200, size, size / 4));
 
     // 6 = ATC info background
     bmp = al_create_bitmap(size, size / 4);
@@ -73,7 +71,7 @@ void annunciator::resize()
     al_draw_scaled_bitmap(orig, 0, 600, 1, 1, 0, 0, size, size / 4, 0);
     addBitmap(bmp);
 
-    al_set_target_backbuffer(globals.display);
+    al_set_target_bitmap(globals.screen);
 }
 
 /// <summary>
@@ -86,29 +84,32 @@ void annunciator::render()
     }
 
     // Use normal blender
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
-
-    // Draw stuff into dest bitmap
-    al_set_target_bitmap(bitmaps[1]);
+    setBlender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
 
     int state;
-    if (!globals.dataLinked)
-    {
-        // 'No Data Link' message
-        al_draw_bitmap(bitmaps[4], 0, 0, 0);
+    if (!globals.dataLinked) {
         state = 0;
     }
-    else if (!globals.connected)
-    {
-        // 'Not Connected' message
-        al_draw_bitmap(bitmaps[5], 0, 0, 0);
+    else if (!globals.connected) {
         state = 1;
     }
     else {
         state = 2;
+    }
 
-        if (fuelWarning) {
-            al_draw_bitmap(bitmaps[3], 0, 0, 0);
+    // Draw stuff into dest bitmap (only if something has changed) or
+    // straight on screen
+    if (beginRender()) {
+        if (state == 0) {
+            // 'No Data Link' message
+            drawBitmap(bitmaps[4], 0, 0, 0);
+        }
+        else if (state == 1) {
+            // 'Not Connected' message
+            drawBitmap(bitmaps[5], 0, 0, 0);
+        }
+        else if (fuelWarning) {
+            drawBitmap(bitmaps[3], 0, 0, 0);
         }
         else {
             // No warnings
@@ -116,48 +117,30 @@ void annunciator::render()
                 showAtcInfo();
             }
             else {
-                al_draw_bitmap(bitmaps[2], 0, 0, 0);
+                drawBitmap(bitmaps[2], 0, 0, 0);
             }
         }
     }
 
-    // Position dest bitmap on screen
-    al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
-
+    bool dimmed = false;
     if (state != prevState) {
-        dimDelay = 1000;
+        dimTime = latency::now() + DimDelayUs;
         prevState = state;
     }
-    else if (state < 2 && dimDelay > 0) {
-        dimDelay--;
-    }
     else if (!globals.active) {
-        dimInstrument();
+        // Only dim a warning after it has been shown for a while
+        dimmed = state == 2 || latency::now() >= dimTime;
     }
+
+    // Position dest bitmap on screen
+    endRender(dimmed);
 }
 
 void annunciator::showAtcInfo()
 {
-    SimVars* simVars = &globals.simVars->simVars;
-    char callSign[256];
-
-    if (simVars->atcFlightNumber[0] == '\0') {
-        sprintf(callSign, "%s ", simVars->atcCallSign);
-    }
-    else {
-        sprintf(callSign, "%s %s ", simVars->atcCallSign, simVars->atcFlightNumber);
-    }
-
-    if (simVars->atcHeavy == 1) {
-        strcat(callSign, "Heavy");
-    }
-
-    al_draw_bitmap(bitmaps[6], 0, 0, 0);
-    al_draw_text(globals.font, al_map_rgb(0x80, 0x80, 0x80), 20, 20, 0, simVars->atcTailNumber);
-    // Temp hack - Comment next line out
-    //strcpy(callSign, simVars->aircraft);
-    al_draw_text(globals.font, al_map_rgb(0x80, 0x80, 0x80), 20, 40, 0, callSign);
+    drawBitmap(bitmaps[6], 0, 0, 0);
+    drawText(globals.font, al_map_rgb(0x80, 0x80, 0x80), 20, 20, 0, tailNumber);
+    drawText(globals.font, al_map_rgb(0x80, 0x80, 0x80), 20, 40, 0, callSign);
 }
 
 /// <summary>
@@ -172,7 +155,7 @@ void annunciator::update()
     xPos = settings[0];
     yPos = settings[1];
 
-    if (size != settings[2]) {
+    if (sizeChanged(settings[2])) {
         size = settings[2];
         resize();
     }
@@ -185,9 +168,24 @@ void annunciator::update()
 #endif
 
     // Get latest FlightSim variables
-    SimVars* simVars = &globals.simVars->simVars;
+    SimVars* simVars = globals.simVars->simVars;
 
     // Calculate values
+    strcpy(tailNumber, simVars->atcTailNumber);
+
+    if (simVars->atcFlightNumber[0] == '\0') {
+        sprintf(callSign, "%s ", simVars->atcCallSign);
+    }
+    else {
+        sprintf(callSign, "%s %s ", simVars->atcCallSign, simVars->atcFlightNumber);
+    }
+
+    if (simVars->atcHeavy == 1) {
+        strcat(callSign, "Heavy");
+    }
+    // Temp hack - Comment next line out
+    //strcpy(callSign, simVars->aircraft);
+
     double fuelLevel = (simVars->fuelLeft + simVars->fuelRight) / 2;
 
     // Warning at 5 gallons = 19%
@@ -228,6 +226,21 @@ void annunciator::update()
     }
 }
 
+/// <summary>
+/// Add FlightSim variables for this instrument (used for simulation mode)
+/// </summary>
+void annunciator::addVars()
+{
+    // Owned by other instruments
+    globals.simVars->useVar(name, "Fuel Tank Left Main Level");
+    globals.simVars->useVar(name, "Fuel Tank Right Main Level");
+
+    globals.simVars->useVar(name, "Atc Id");
+    globals.simVars->useVar(name, "Atc Airline");
+    globals.simVars->useVar(name, "Atc Flight Number");
+    globals.simVars->useVar(name, "Atc Heavy");
+}
+
 #ifndef _WIN32
 
 void annunciator::addKnobs()
@@ -9,6 +9,9 @@
 class annunciator : public instrument
 {
 private:
+    // Time a warning is shown before it can be dimmed
+    static const int64_t DimDelayUs = 33000000;
+
     float scaleFactor;
 
     // Instrument values (caclulated from variables and needed to draw the instrument)
@@ -22,7 +25,9 @@ private:
 #else
     timespec lastFlash;
 #endif
-    int dimDelay;
+    int64_t dimTime;
+    char tailNumber[64] = "";
+    char callSign[96] = "";
 
     // Hardware knobs
     int selSwitch = -1;
@@ -35,6 +40,7 @@ public:
 
 private:
     void resize();
+    void addVars();
     void addKnobs();
     void updateKnobs();
 };
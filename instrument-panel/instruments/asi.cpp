@@ -17,6 +17,16 @@ asi::asi(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
     }
 #endif
 
+    // Values that change how the instrument looks
+    addState(&airspeedCal);
+    addState(&airspeedAngle);
+    addState(&machAngle);
+
+    // Keep every sheet loaded so a resize never has to decode them again
+    keepBitmap("asi.png");
+    keepBitmap("asi-fast.png");
+    keepBitmap("asi-savage-cub.png");
+
     resize();
 }
 
@@ -26,21 +36,27 @@ asi::asi(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 void asi::resize()
 {
     destroyBitmaps();
-    loadedAircraft = globals.aircraft;
 
-    if (globals.simVars->simVars.cruiseSpeed >= globals.FastPlaneSpeed) {
-        resizeFast();
-        return;
-    }
+    // Build every dial so an aircraft change only has to select one
+    selectVariant(SlowDial);
+    resizeSlow("asi.png");
 
-    // Create bitmaps scaled to correct size (original size is 800)
-    scaleFactor = size / 800.0f;
+    selectVariant(CubDial);
+    resizeSlow("asi-savage-cub.png");
 
-    char origName[256] = "asi.png";
+    selectVariant(FastDial);
+    resizeFast();
 
-    if (globals.aircraft == globals.SAVAGE_CUB) {
-        strcpy(origName, "asi-savage-cub.png");
-    }
+    selectDial();
+}
+
+/// <summary>
+/// Builds the bitmaps for slower planes from the given sheet.
+/// </summary>
+void asi::resizeSlow(const char* origName)
+{
+    // Create bitmaps scaled to correct size (original size is 800)
+    scaleFactor = size / 800.0f;
 
     // 0 = Original (loaded) bitmap
     ALLEGRO_BITMAP* orig = loadBitmap(origName);
@@ -61,10 +77,7 @@ void asi::resize()
     addBitmap(bmp);
 
     // 3 = Outer scale shadow
-    bmp = al_create_bitmap(size, 180 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 0, 1600, 800, 180, 0, 0, size, 180 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 0, 1600, 800, 180, size, 180 * scaleFactor));
 
     // 4 = Pointer
     bmp = al_create_bitmap(80, 800);
@@ -78,7 +91,10 @@ void asi::resize()
     al_draw_bitmap_region(orig, 800, 800, 80, 800, 0, 0, 0);
     addBitmap(bmp);
 
-    al_set_target_backbuffer(globals.display);
+    // 6 = Main dial
+    addBitmap(bakeLayer(orig, 0, 0, 800, 800, size, size));
+
+    al_set_target_bitmap(globals.screen);
 }
 
 /// <summary>
@@ -111,34 +127,43 @@ void asi::resizeFast()
     addBitmap(outer);
 
     // 3 = Main dial shadow
-    ALLEGRO_BITMAP* shadowBackground = al_create_bitmap(800, 800);
-    al_set_target_bitmap(shadowBackground);
-    al_draw_scaled_bitmap(orig, 801, 801, 800, 800, 0, 0, fsize, fsize, 0);
-    addBitmap(shadowBackground);
-
-    // 4 = Shadow sprite (to be rotated)
-    ALLEGRO_BITMAP* shadowBackground2 = al_create_bitmap(800, 800);
-    addBitmap(shadowBackground2);
-
-    // 5 = Shadow sprite
-    ALLEGRO_BITMAP* shadow = al_create_bitmap(149 * scaleFactor, 609 * scaleFactor);
-    al_set_target_bitmap(shadow);
-    al_draw_scaled_bitmap(orig, 513, 863, 149, 609, 0, 0, 149 * scaleFactor, 609 * scaleFactor, 0);
-    addBitmap(shadow);
-
-    // 6 = Pointer sprite
+    addBitmap(bakeLayer(orig, 801, 801, 800, 800, fsize, fsize));
+
+    // 4 = Shadow sprite
+    addBitmap(bakeLayer(orig, 513, 863, 149, 609, 149 * scaleFactor, 609 * scaleFactor));
+
+    // 5 = Pointer sprite
     ALLEGRO_BITMAP* pointer = al_create_bitmap(111, 581);
     al_set_target_bitmap(pointer);
     al_draw_bitmap_region(orig, 153, 881, 111, 581, 0, 0, 0);
     addBitmap(pointer);
 
-    // 7 = Fill with background colour (takes 1 pixel of background and scales it)
+    // 6 = Fill with background colour (takes 1 pixel of background and scales it)
     ALLEGRO_BITMAP* bg = al_create_bitmap(fsize, fsize);
     al_set_target_bitmap(bg);
     al_draw_scaled_bitmap(orig, 75, 61, 1, 1, 0, 0, fsize, fsize, 0);
     addBitmap(bg);
 
-    al_set_target_backbuffer(globals.display);
+    // 7 = Main dial
+    addBitmap(bakeLayer(orig, 0, 0, 800, 800, fsize, fsize));
+
+    al_set_target_bitmap(globals.screen);
+}
+
+/// <summary>
+/// Selects the dial for the current aircraft. All dials are already
+/// built so this can be done on any frame without a hitch.
+/// </summary>
+void asi::selectDial()
+{
+    if (fastPlane) {
+        selectVariant(FastDial);
+        scaleFactor = (int)(size * FastPlaneSizeFactor) / 800.0f;
+    }
+    else {
+        selectVariant(savageCub ? CubDial : SlowDial);
+        scaleFactor = size / 800.0f;
+    }
 }
 
 /// <summary>
@@ -146,60 +171,56 @@ void asi::resizeFast()
 /// </summary>
 void asi::render()
 {
-    if (bitmaps[0] == NULL || loadedAircraft != globals.aircraft) {
+    if (bitmaps[0] == NULL) {
         return;
     }
 
-    if (globals.simVars->simVars.cruiseSpeed >= globals.FastPlaneSpeed) {
+    if (fastPlane) {
         renderFast();
         return;
     }
 
     // Use normal blender
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+    setBlender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
 
-    // Draw stuff into dest bitmap
-    al_set_target_bitmap(bitmaps[1]);
+    // Draw stuff into dest bitmap (only if something has changed) or
+    // straight on screen
+    if (beginRender()) {
+        // Add outer scale (adjusted airspeed) and rotate
+        // 0 = 0 radians
+        drawScaledRotatedBitmap(bitmaps[2], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, airspeedCal * DegreesToRadians, 0);
 
-    // Add outer scale (adjusted airspeed) and rotate
-    // 0 = 0 radians
-    al_draw_scaled_rotated_bitmap(bitmaps[2], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, airspeedCal * DegreesToRadians, 0);
+        if (globals.enableShadows) {
+            // Multiply (shades of grey darken, white has no effect)
+            beginShadows();
 
-    if (globals.enableShadows) {
-        // Set blender to multiply (shades of grey darken, white has no effect)
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
+            // Add outer hole Shadow
+            drawBitmapRegion(bitmaps[3], 0, 0, size, 180 * scaleFactor, 10 * scaleFactor, 630 * scaleFactor, 0);
 
-        // Add outer hole Shadow
-        al_draw_bitmap_region(bitmaps[3], 0, 0, size, 180 * scaleFactor, 10 * scaleFactor, 630 * scaleFactor, 0);
+            // Back to normal drawing
+            endShadows();
+        }
 
-        // Restore normal blender
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
-    }
+        // Add main dial
+        drawBitmap(bitmaps[6], 0, 0, 0);
 
-    // Add main dial
-    al_draw_scaled_bitmap(bitmaps[0], 0, 0, 800, 800, 0, 0, size, size, 0);
+        if (globals.enableShadows) {
+            // Multiply (shades of grey darken, white has no effect)
+            beginShadows();
 
-    if (globals.enableShadows) {
-        // Set blender to multiply (shades of grey darken, white has no effect)
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
+            // Add pointer shadow
+            drawScaledRotatedBitmap(bitmaps[5], 40, 400, 410 * scaleFactor, 410 * scaleFactor, scaleFactor, scaleFactor, airspeedAngle, 0);
 
-        // Add pointer shadow
-        al_draw_scaled_rotated_bitmap(bitmaps[5], 40, 400, 410 * scaleFactor, 410 * scaleFactor, scaleFactor, scaleFactor, airspeedAngle, 0);
+            // Back to normal drawing
+            endShadows();
+        }
 
-        // Restore normal blender
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+        // Add pointer
+        drawScaledRotatedBitmap(bitmaps[4], 40, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, airspeedAngle, 0);
     }
 
-    // Add pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[4], 40, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, airspeedAngle, 0);
-
-    // Position dest bitmap on screen
-    al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
-
-    if (!globals.active) {
-        dimInstrument();
-    }
+    // Position dest bitmap on screen (dimmed when not connected)
+    endRender(!globals.active);
 }
 
 /// <summary>
@@ -208,61 +229,46 @@ void asi::render()
 void asi::renderFast()
 {
     int fsize = size * FastPlaneSizeFactor;
+    int fadjust = (fsize - size) / 2;
 
     // Use normal blender
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
-
-    // Draw stuff into dest bitmap
-    al_set_target_bitmap(bitmaps[1]);
-
-    // Draw background colour
-    al_draw_bitmap(bitmaps[7], 0, 0, 0);
-
-    // Display outer dial
-    float centre = fsize / 2.0f;
-    al_draw_scaled_rotated_bitmap(bitmaps[2], 400, 400, centre, centre, scaleFactor, scaleFactor, machAngle * AngleFactor, 0);
-
-    if (globals.enableShadows) {
-        // Display main dial shadow
-        // Set blender to multiply (shades of grey darken, white has no effect)
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
-        al_draw_bitmap(bitmaps[3], 0, 0, 0);
-        // Restore normal blender
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
-    }
-
-    // Display dial (contains transparencies) over outer dial
-    al_draw_scaled_bitmap(bitmaps[0], 0, 0, 800, 800, 0, 0, fsize, fsize, 0);
+    setBlender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+
+    // Draw stuff into dest bitmap (only if something has changed) or
+    // straight on screen. Dest bitmap is larger than the instrument.
+    if (beginRender(xPos - fadjust, yPos - fadjust, fsize, fsize)) {
+        // Draw background colour
+        drawBitmap(bitmaps[6], 0, 0, 0);
+
+        // Display outer dial
+        float centre = fsize / 2.0f;
+        drawScaledRotatedBitmap(bitmaps[2], 400, 400, centre, centre, scaleFactor, scaleFactor, machAngle * AngleFactor, 0);
+
+        if (globals.enableShadows) {
+            // Display main dial shadow
+            // Multiply (shades of grey darken, white has no effect)
+            beginShadows();
+            drawBitmap(bitmaps[3], 0, 0, 0);
+            // Back to normal drawing
+            endShadows();
+        }
 
-    if (globals.enableShadows) {
-        // Fill shadow_background bitmap with white
-        al_set_target_bitmap(bitmaps[4]);
-        al_draw_scaled_bitmap(bitmaps[0], 513, 863, 1, 1, 0, 0, fsize, fsize, 0);
+        // Display dial (contains transparencies) over outer dial
+        drawBitmap(bitmaps[7], 0, 0, 0);
 
-        // Write shadow sprite to shadow background
-        al_draw_rotated_bitmap(bitmaps[5], 76 * scaleFactor, 367 * scaleFactor, 410 * scaleFactor, 430 * scaleFactor, airspeedAngle * AngleFactor, 0);
-        al_set_target_bitmap(bitmaps[1]);
+        if (globals.enableShadows) {
+            // Multiply rotated shadow sprite straight into dest
+            beginShadows();
+            drawRotatedBitmap(bitmaps[4], 76 * scaleFactor, 367 * scaleFactor, 410 * scaleFactor, 430 * scaleFactor, airspeedAngle * AngleFactor, 0);
+            endShadows();
+        }
 
-        // Draw shadow
-        // Set blender to multiply (shades of grey darken, white has no effect)
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
-        al_draw_bitmap(bitmaps[4], 0, 0, 0);
-        // Restore normal blender
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+        // Draw needle pointer at angle
+        drawScaledRotatedBitmap(bitmaps[5], 54, 348, centre, centre, scaleFactor, scaleFactor, airspeedAngle * AngleFactor, 0);
     }
 
-    // Draw needle pointer at angle
-    al_draw_scaled_rotated_bitmap(bitmaps[6], 54, 348, centre, centre, scaleFactor, scaleFactor, airspeedAngle * AngleFactor, 0);
-
-    // Position dest bitmap on screen
-    al_set_target_backbuffer(globals.display);
-
-    int fadjust = (fsize - size) / 2;
-    al_draw_bitmap(bitmaps[1], xPos - fadjust, yPos - fadjust, 0);
-
-    if (!globals.active) {
-        dimInstrument();
-    }
+    // Position dest bitmap on screen (dimmed when not connected)
+    endRender(!globals.active);
 }
 
 /// <summary>
@@ -277,10 +283,19 @@ void asi::update()
     xPos = settings[0];
     yPos = settings[1];
 
-    if (size != settings[2] || loadedAircraft != globals.aircraft) {
+    // Only switch dials between frames so render always draws the
+    // bitmaps of the dial it was selected for, even if the aircraft
+    // changes mid frame
+    fastPlane = globals.simVars->simVars->cruiseSpeed >= globals.FastPlaneSpeed;
+    savageCub = globals.aircraft == globals.SAVAGE_CUB;
+
+    if (sizeChanged(settings[2])) {
         size = settings[2];
         resize();
     }
+    else {
+        selectDial();
+    }
 
 #ifndef _WIN32
     // Only have hardware knobs on Raspberry Pi
@@ -289,18 +304,18 @@ void asi::update()
     }
 #endif
 
-    if (globals.simVars->simVars.cruiseSpeed >= globals.FastPlaneSpeed) {
+    if (fastPlane) {
         updateFast();
         return;
     }
 
     // Get latest FlightSim variables
-    SimVars* simVars = &globals.simVars->simVars;
+    SimVars* simVars = globals.simVars->simVars;
 
     airspeedCal = -35 - (simVars->asiAirspeedCal * 2.5);
 
     // Calculate values - Not a linear scale!
-    if (globals.aircraft == globals.SAVAGE_CUB) {
+    if (savageCub) {
         airspeedKnots = simVars->asiAirspeed * 2;
     }
     else {
@@ -331,7 +346,7 @@ void asi::update()
 void asi::updateFast()
 {
     // Get latest FlightSim variables
-    SimVars* simVars = &globals.simVars->simVars;
+    SimVars* simVars = globals.simVars->simVars;
 
     // Calculate airspeed angle
     double speed = simVars->asiAirspeed / 10.0f;
@@ -409,7 +424,7 @@ void asi::updateKnobs()
         // Change calibration by knob movement amount (adjust for desired sensitivity)
         int adjust = (int)((prevVal - val) / 2);
         if (adjust != 0) {
-            double newVal = globals.simVars->simVars.asiAirspeedCal + adjust;
+            double newVal = globals.simVars->simVars->asiAirspeedCal + adjust;
 
             globals.simVars->write(KEY_TRUE_AIRSPEED_CAL_SET, newVal);
             prevVal = val;
@@ -8,10 +8,16 @@ class asi : public instrument
 private:
     const double FastPlaneSizeFactor = 1.075;
 
+    // Variants (see selectVariant)
+    static const int SlowDial = 0;
+    static const int CubDial = 1;
+    static const int FastDial = 2;
+
     float scaleFactor;
 
     // Instrument values (calculated from variables and needed to draw the instrument)
-    int loadedAircraft;
+    bool fastPlane = false;
+    bool savageCub = false;
     double airspeedCal;
     double airspeedKnots;
     double airspeedAngle = 0;
@@ -33,7 +39,9 @@ public:
 private:
     void renderFast();
     void resize();
+    void resizeSlow(const char* origName);
     void resizeFast();
+    void selectDial();
     void updateFast();
     void addVars();
     void addKnobs();
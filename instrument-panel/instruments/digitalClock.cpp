@@ -16,6 +16,21 @@ digitalClock::digitalClock(int xPos, int yPos, int size) : instrument(xPos, yPos
     }
 #endif
 
+    // Values that change how the instrument looks
+    addState(&displayView);
+    addState(&clockView);
+    addState(&voltsx10);
+    addState(&tempFx10);
+    addState(&tempCx10);
+    addState(&utcHours);
+    addState(&utcMins);
+    addState(&localHours);
+    addState(&localMins);
+    addState(&flightHours);
+    addState(&flightMins);
+    addState(&elapsedMins);
+    addState(&elapsedSecs);
+
     resize();
     time(&flightStartTime);
 }
@@ -43,102 +58,54 @@ void digitalClock::resize()
     addBitmap(bmp);
 
     // 2 = Main panel
-    bmp = al_create_bitmap(size, size);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 0, 0, 800, 800, 0, 0, size, size, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 0, 0, 800, 800, size, size));
 
     // 3 = Selector arrow
-    bmp = al_create_bitmap(52 * scaleFactor, 30 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 800, 0, 52, 30, 0, 0, 52 * scaleFactor, 30 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 800, 0, 52, 30, 52 * scaleFactor, 30 * scaleFactor));
 
     // 4 = Digit 0
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 0, 800, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 0, 800, 94, 134, 94 * scaleFactor, 134 * scaleFactor));
 
     // 5 = Digit 1
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 94, 800, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 94, 800, 94, 134, 94 * scaleFactor, 134 * scaleFactor));
 
     // 6 = Digit 2
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 188, 800, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 188, 800, 94, 134, 94 * scaleFactor, 134 * scaleFactor));
 
     // 7 = Digit 3
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 282, 800, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 282, 800, 94, 134, 94 * scaleFactor, 134 * scaleFactor));
 
     // 8 = Digit 4
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 376, 800, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 376, 800, 94, 134, 94 * scaleFactor, 134 * scaleFactor));
 
     // 9 = Digit 5
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 470, 800, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 470, 800, 94, 134, 94 * scaleFactor, 134 * scaleFactor));
 
     // 10 = Digit 6
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 564, 800, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 564, 800, 94, 134, 94 * scaleFactor, 134 * scaleFactor));
 
     // 11 = Digit 7
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 658, 800, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 658, 800, 94, 134, 94 * scaleFactor, 134 * scaleFactor));
 
     // 12 = Digit 8
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 752, 800, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 752, 800, 94, 134, 94 * scaleFactor, 134 * scaleFactor));
 
     // 13 = Digit 9
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 800, 666, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 800, 666, 94, 134, 94 * scaleFactor, 134 * scaleFactor));
 
     // 14 = Minus
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 800, 130, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 800, 130, 94, 134, 94 * scaleFactor, 134 * scaleFactor));
 
     // 15 = Letter E
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 800, 264, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 800, 264, 94, 134, 94 * scaleFactor, 134 * scaleFactor));
 
     // 16 = Letter F
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 800, 398, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 800, 398, 94, 134, 94 * scaleFactor, 134 * scaleFactor));
 
     // 17 = Letter C
-    bmp = al_create_bitmap(94 * scaleFactor, 134 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 800, 532, 94, 134, 0, 0, 94 * scaleFactor, 134 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 800, 532, 94, 134, 94 * scaleFactor, 134 * scaleFactor));
 
-    al_set_target_backbuffer(globals.display);
+    al_set_target_bitmap(globals.screen);
 }
 
 /// <summary>
@@ -151,82 +118,78 @@ void digitalClock::render()
     }
 
     // Use normal blender
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
-
-    // Draw stuff into dest bitmap
-    al_set_target_bitmap(bitmaps[1]);
+    setBlender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
 
-    // Add main panel
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+    // Draw stuff into dest bitmap (only if something has changed) or
+    // straight on screen
+    if (beginRender()) {
+        // Add main panel
+        drawBitmap(bitmaps[2], 0, 0, 0);
 
-    // Add selector arrow
-    int arrowX;
-    int arrowY;
+        // Add selector arrow
+        int arrowX;
+        int arrowY;
 
-    if (clockView == UtcTime || clockView == FlightTime) {
-        arrowX = 111;
-    }
-    else {
-        arrowX = 196;
-    }
-
-    if (clockView == UtcTime || clockView == LocalTime) {
-        arrowY = 464;
-    }
-    else {
-        arrowY = 550;
-    }
-
-    al_draw_bitmap(bitmaps[3], arrowX * scaleFactor, arrowY * scaleFactor, 0);
-
-    switch (displayView) {
-    case Voltage:
-        drawDisplay(voltsx10 / 100, (voltsx10 / 10) % 10, voltsx10 % 10, 0);
-        break;
-
-    case Farenheit:
-        if (tempFx10 < 0) {
-            drawDisplay(-tempFx10 / 100, (-tempFx10 / 10) % 10, -tempFx10 % 10, 1, true);
+        if (clockView == UtcTime || clockView == FlightTime) {
+            arrowX = 111;
         }
         else {
-            drawDisplay(tempFx10 / 100, (tempFx10 / 10) % 10, tempFx10 % 10, 1);
+            arrowX = 196;
         }
-        break;
 
-    case Celsius:
-        if (tempCx10 < 0) {
-            drawDisplay(-tempCx10 / 100, (-tempCx10 / 10) % 10, -tempCx10 % 10, 2, true);
+        if (clockView == UtcTime || clockView == LocalTime) {
+            arrowY = 464;
         }
         else {
-            drawDisplay(tempCx10 / 100, (tempCx10 / 10) % 10, tempCx10 % 10, 2);
+            arrowY = 550;
         }
-        break;
-    }
 
-    switch (clockView) {
-    case UtcTime:
-        drawClock(utcHours / 10, utcHours % 10, utcMins / 10, utcMins % 10);
-        break;
+        drawBitmap(bitmaps[3], arrowX * scaleFactor, arrowY * scaleFactor, 0);
 
-    case LocalTime:
-        drawClock(localHours / 10, localHours % 10, localMins / 10, localMins % 10);
-        break;
+        switch (displayView) {
+        case Voltage:
+            drawDisplay(voltsx10 / 100, (voltsx10 / 10) % 10, voltsx10 % 10, 0);
+            break;
 
-    case FlightTime:
-        drawClock(flightHours / 10, flightHours % 10, flightMins / 10, flightMins % 10);
-        break;
+        case Farenheit:
+            if (tempFx10 < 0) {
+                drawDisplay(-tempFx10 / 100, (-tempFx10 / 10) % 10, -tempFx10 % 10, 1, true);
+            }
+            else {
+                drawDisplay(tempFx10 / 100, (tempFx10 / 10) % 10, tempFx10 % 10, 1);
+            }
+            break;
 
-    case ElapsedTime:
-        drawClock(elapsedMins / 10, elapsedMins % 10, elapsedSecs / 10, elapsedSecs % 10);
-        break;
-    }
+        case Celsius:
+            if (tempCx10 < 0) {
+                drawDisplay(-tempCx10 / 100, (-tempCx10 / 10) % 10, -tempCx10 % 10, 2, true);
+            }
+            else {
+                drawDisplay(tempCx10 / 100, (tempCx10 / 10) % 10, tempCx10 % 10, 2);
+            }
+            break;
+        }
 
-    al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+        switch (clockView) {
+        case UtcTime:
+            drawClock(utcHours / 10, utcHours % 10, utcMins / 10, utcMins % 10);
+            break;
 
-    if (!globals.active) {
-        dimInstrument();
+        case LocalTime:
+            drawClock(localHours / 10, localHours % 10, localMins / 10, localMins % 10);
+            break;
+
+        case FlightTime:
+            drawClock(flightHours / 10, flightHours % 10, flightMins / 10, flightMins % 10);
+            break;
+
+        case ElapsedTime:
+            drawClock(elapsedMins / 10, elapsedMins % 10, elapsedSecs / 10, elapsedSecs % 10);
+            break;
+        }
     }
+
+    endRender(!globals.active);
 }
 
 /// <summary>
@@ -239,25 +202,25 @@ void digitalClock::drawDisplay(int digit1, int digit2, int digit3, int letter, b
     // Temps can be negative
     if (isMinus) {
         if (digit1 > 0) {
-            al_draw_bitmap(bitmaps[14], 85 * scaleFactor, y, 0);
+            drawBitmap(bitmaps[14], 85 * scaleFactor, y, 0);
         }
         else {
-            al_draw_bitmap(bitmaps[14], 187 * scaleFactor, y, 0);
+            drawBitmap(bitmaps[14], 187 * scaleFactor, y, 0);
         }
     }
 
     // Farenheit can be > 99
     if (digit1 > 9) {
-        al_draw_bitmap(bitmaps[5], 85 * scaleFactor, y, 0);
+        drawBitmap(bitmaps[5], 85 * scaleFactor, y, 0);
     }
 
     if (digit1 > 0) {
-        al_draw_bitmap(bitmaps[4 + (digit1 % 10)], 187 * scaleFactor, y, 0);
+        drawBitmap(bitmaps[4 + (digit1 % 10)], 187 * scaleFactor, y, 0);
     }
 
-    al_draw_bitmap(bitmaps[4 + digit2], 289 * scaleFactor, y, 0);
-    al_draw_bitmap(bitmaps[4 + digit3], 417 * scaleFactor, y, 0);
-    al_draw_bitmap(bitmaps[15 + letter], 519 * scaleFactor, y, 0);
+    drawBitmap(bitmaps[4 + digit2], 289 * scaleFactor, y, 0);
+    drawBitmap(bitmaps[4 + digit3], 417 * scaleFactor, y, 0);
+    drawBitmap(bitmaps[15 + letter], 519 * scaleFactor, y, 0);
 }
 
 /// <summary>
@@ -267,10 +230,10 @@ void digitalClock::drawClock(int digit1, int digit2, int digit3, int digit4)
 {
     int y = 430 * scaleFactor;
 
-    al_draw_bitmap(bitmaps[4 + digit1], 277 * scaleFactor, y, 0);
-    al_draw_bitmap(bitmaps[4 + digit2], 379 * scaleFactor, y, 0);
-    al_draw_bitmap(bitmaps[4 + digit3], 507 * scaleFactor, y, 0);
-    al_draw_bitmap(bitmaps[4 + digit4], 609 * scaleFactor, y, 0);
+    drawBitmap(bitmaps[4 + digit1], 277 * scaleFactor, y, 0);
+    drawBitmap(bitmaps[4 + digit2], 379 * scaleFactor, y, 0);
+    drawBitmap(bitmaps[4 + digit3], 507 * scaleFactor, y, 0);
+    drawBitmap(bitmaps[4 + digit4], 609 * scaleFactor, y, 0);
 }
 
 /// <summary>
@@ -285,7 +248,7 @@ void digitalClock::update()
     xPos = settings[0];
     yPos = settings[1];
 
-    if (size != settings[2]) {
+    if (sizeChanged(settings[2])) {
         size = settings[2];
         resize();
     }
@@ -298,7 +261,7 @@ void digitalClock::update()
 #endif
 
     // Get latest FlightSim variables
-    SimVars* simVars = &globals.simVars->simVars;
+    SimVars* simVars = globals.simVars->simVars;
 
     // Calculate values
     voltsx10 = simVars->dcVolts * 10 + 0.5;
@@ -344,6 +307,7 @@ void digitalClock::addVars()
     globals.simVars->addVar(name, "Local Time", false, 60, 46800);
     globals.simVars->addVar(name, "Absolute Time", false, 60, 0);
     globals.simVars->addVar(name, "Electrical Battery Bus Voltage", false, 0.1, 23.7);
+    globals.simVars->useVar(name, "Ambient Temperature");
 }
 
 #ifndef _WIN32
@@ -8,6 +8,12 @@ egt::egt(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
     setName("EGT");
     addVars();
+
+    // Values that change how the instrument looks
+    addState(&egtAngle);
+    addState(&egtRefAngle);
+    addState(&flowAngle);
+
     resize();
 }
 
@@ -34,16 +40,10 @@ void egt::resize()
     addBitmap(bmp);
 
     // 2 = Dials
-    bmp = al_create_bitmap(size, size);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 0, 0, 400, 400, 0, 0, size, size, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 0, 0, 400, 400, size, size));
 
     // 3 = Top layer
-    bmp = al_create_bitmap(size, size);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 0, 400, 400, 400, 0, 0, size, size, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 0, 400, 400, 400, size, size));
 
     // 4 = Flow Pointer
     bmp = al_create_bitmap(200, 40);
@@ -63,7 +63,7 @@ void egt::resize()
     al_draw_bitmap_region(orig, 7, 880, 155, 40, 0, 0, 0);
     addBitmap(bmp);
     
-    al_set_target_backbuffer(globals.display);
+    al_set_target_bitmap(globals.screen);
 }
 
 /// <summary>
@@ -76,35 +76,31 @@ void egt::render()
     }
 
     // Use normal blender
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
-
-    // Draw stuff into dest bitmap
-    al_set_target_bitmap(bitmaps[1]);
+    setBlender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
 
-    // Add dials
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+    // Draw stuff into dest bitmap (only if something has changed) or
+    // straight on screen
+    if (beginRender()) {
+        // Add dials
+        drawBitmap(bitmaps[2], 0, 0, 0);
 
-   
 
-    // Add Flow pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[4], 186, 20, 386 * scaleFactor, 200 * scaleFactor, scaleFactor, scaleFactor, flowAngle * DegreesToRadians, 0);
 
-    // Add EGT pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[5], 0, 20, 38 * scaleFactor, 200 * scaleFactor, scaleFactor, scaleFactor, egtAngle * DegreesToRadians, 0);
+        // Add Flow pointer
+        drawScaledRotatedBitmap(bitmaps[4], 186, 20, 386 * scaleFactor, 200 * scaleFactor, scaleFactor, scaleFactor, flowAngle * DegreesToRadians, 0);
 
-    // Add EGT Ref pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[6], 0, 20, 38 * scaleFactor, 200 * scaleFactor, scaleFactor, scaleFactor, egtRefAngle * DegreesToRadians, 0);
+        // Add EGT pointer
+        drawScaledRotatedBitmap(bitmaps[5], 0, 20, 38 * scaleFactor, 200 * scaleFactor, scaleFactor, scaleFactor, egtAngle * DegreesToRadians, 0);
 
-    // Add top layer
-    al_draw_bitmap(bitmaps[3], 0, 0, 0);
+        // Add EGT Ref pointer
+        drawScaledRotatedBitmap(bitmaps[6], 0, 20, 38 * scaleFactor, 200 * scaleFactor, scaleFactor, scaleFactor, egtRefAngle * DegreesToRadians, 0);
 
-    // Position dest bitmap on screen
-    al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
-
-    if (!globals.active) {
-        dimInstrument();
+        // Add top layer
+        drawBitmap(bitmaps[3], 0, 0, 0);
     }
+
+    // Position dest bitmap on screen (dimmed when not connected)
+    endRender(!globals.active);
 }
 
 /// <summary>
@@ -119,13 +115,13 @@ void egt::update()
     xPos = settings[0];
     yPos = settings[1];
 
-    if (size != settings[2]) {
+    if (sizeChanged(settings[2])) {
         size = settings[2];
         resize();
     }
 
     // Get latest FlightSim variables
-    SimVars* simVars = &globals.simVars->simVars;
+    SimVars* simVars = globals.simVars->simVars;
 
     // Calculate values
     if (simVars->exhaustGasTemp < 680)
@@ -8,6 +8,11 @@ fuel::fuel(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
     setName("Fuel");
     addVars();
+
+    // Values that change how the instrument looks
+    addState(&angleLeft);
+    addState(&angleRight);
+
     resize();
 }
 
@@ -34,16 +39,10 @@ void fuel::resize()
     addBitmap(bmp);
 
     // 2 = Dials
-    bmp = al_create_bitmap(size, size);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 0, 0, 400, 400, 0, 0, size, size, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 0, 0, 400, 400, size, size));
 
     // 3 = Top layer
-    bmp = al_create_bitmap(size, size);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 0, 400, 400, 400, 0, 0, size, size, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 0, 400, 400, 400, size, size));
 
     // 4 = Pointer
     bmp = al_create_bitmap(200, 40);
@@ -57,7 +56,7 @@ void fuel::resize()
     al_draw_bitmap_region(orig, 200, 800, 200, 40, 0, 0, 0);
     addBitmap(bmp);
 
-    al_set_target_backbuffer(globals.display);
+    al_set_target_bitmap(globals.screen);
 }
 
 /// <summary>
@@ -70,44 +69,40 @@ void fuel::render()
     }
 
     // Use normal blender
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+    setBlender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
 
-    // Draw stuff into dest bitmap
-    al_set_target_bitmap(bitmaps[1]);
+    // Draw stuff into dest bitmap (only if something has changed) or
+    // straight on screen
+    if (beginRender()) {
+        // Add dials
+        drawBitmap(bitmaps[2], 0, 0, 0);
 
-    // Add dials
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+        if (globals.enableShadows) {
+            // Multiply (shades of grey darken, white has no effect)
+            beginShadows();
 
-    if (globals.enableShadows) {
-        // Set blender to multiply (shades of grey darken, white has no effect)
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
+            // Add left pointer shadow
+            drawScaledRotatedBitmap(bitmaps[5], 72, 20, 82 * scaleFactor, 210 * scaleFactor, scaleFactor, scaleFactor, angleLeft * DegreesToRadians, 0);
 
-        // Add left pointer shadow
-        al_draw_scaled_rotated_bitmap(bitmaps[5], 72, 20, 82 * scaleFactor, 210 * scaleFactor, scaleFactor, scaleFactor, angleLeft * DegreesToRadians, 0);
+            // Add right pointer shadow
+            drawScaledRotatedBitmap(bitmaps[5], 72, 20, 338 * scaleFactor, 210 * scaleFactor, scaleFactor, scaleFactor, angleRight * DegreesToRadians, 0);
 
-        // Add right pointer shadow
-        al_draw_scaled_rotated_bitmap(bitmaps[5], 72, 20, 338 * scaleFactor, 210 * scaleFactor, scaleFactor, scaleFactor, angleRight * DegreesToRadians, 0);
+            // Back to normal drawing
+            endShadows();
+        }
 
-        // Restore normal blender
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
-    }
-
-    // Add left pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[4], 72, 20, 72 * scaleFactor, 200 * scaleFactor, scaleFactor, scaleFactor, angleLeft * DegreesToRadians, 0);
-
-    // Add right pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[4], 72, 20, 328 * scaleFactor, 200 * scaleFactor, scaleFactor, scaleFactor, angleRight * DegreesToRadians, 0);
+        // Add left pointer
+        drawScaledRotatedBitmap(bitmaps[4], 72, 20, 72 * scaleFactor, 200 * scaleFactor, scaleFactor, scaleFactor, angleLeft * DegreesToRadians, 0);
 
-    // Add top layer
-    al_draw_bitmap(bitmaps[3], 0, 0, 0);
+        // Add right pointer
+        drawScaledRotatedBitmap(bitmaps[4], 72, 20, 328 * scaleFactor, 200 * scaleFactor, scaleFactor, scaleFactor, angleRight * DegreesToRadians, 0);
 
-    // Position dest bitmap on screen
-    al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
-
-    if (!globals.active) {
-        dimInstrument();
+        // Add top layer
+        drawBitmap(bitmaps[3], 0, 0, 0);
     }
+
+    // Position dest bitmap on screen (dimmed when not connected)
+    endRender(!globals.active);
 }
 
 /// <summary>
@@ -122,13 +117,13 @@ void fuel::update()
     xPos = settings[0];
     yPos = settings[1];
 
-    if (size != settings[2]) {
+    if (sizeChanged(settings[2])) {
         size = settings[2];
         resize();
     }
 
     // Get latest FlightSim variables
-    SimVars* simVars = &globals.simVars->simVars;
+    SimVars* simVars = globals.simVars->simVars;
 
     // Calculate values
     angleLeft = 51 - simVars->fuelLeft * 1.02;
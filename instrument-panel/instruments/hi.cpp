@@ -18,6 +18,10 @@ hi::hi(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
     }
 #endif
 
+    // Values that change how the instrument looks
+    addState(&angle);
+    addState(&bugAngle);
+
     resize();
 }
 
@@ -50,10 +54,7 @@ void hi::resize()
     addBitmap(bmp);
 
     // 3 = Plane
-    bmp = al_create_bitmap(size, size);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 800, 0, 800, 800, 0, 0, size, size, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 800, 0, 800, 800, size, size));
 
     // 4 = Heading bug
     bmp = al_create_bitmap(80, 80);
@@ -67,7 +68,7 @@ void hi::resize()
     al_draw_bitmap_region(orig, 1600, 400, 80, 80, 0, 0, 0);
     addBitmap(bmp);
 
-    al_set_target_backbuffer(globals.display);
+    al_set_target_bitmap(globals.screen);
 }
 
 /// <summary>
@@ -80,37 +81,33 @@ void hi::render()
     }
 
     // Use normal blender
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+    setBlender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
 
-    // Draw stuff into dest bitmap
-    al_set_target_bitmap(bitmaps[1]);
+    // Draw stuff into dest bitmap (only if something has changed) or
+    // straight on screen
+    if (beginRender()) {
+        // Add dial
+        drawScaledRotatedBitmap(bitmaps[2], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle, 0);
 
-    // Add dial
-    al_draw_scaled_rotated_bitmap(bitmaps[2], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle, 0);
+        // Add plane
+        drawBitmap(bitmaps[3], 0, 0, 0);
 
-    // Add plane
-    al_draw_bitmap(bitmaps[3], 0, 0, 0);
+        if (globals.enableShadows) {
+            // Multiply (shades of grey darken, white has no effect)
+            beginShadows();
 
-    if (globals.enableShadows) {
-        // Set blender to multiply (shades of grey darken, white has no effect)
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
+            // Add heading bug shadow
+            drawScaledRotatedBitmap(bitmaps[5], 40, 400, 410 * scaleFactor, 408 * scaleFactor, scaleFactor, scaleFactor, bugAngle, 0);
 
-        // Add heading bug shadow
-        al_draw_scaled_rotated_bitmap(bitmaps[5], 40, 400, 410 * scaleFactor, 408 * scaleFactor, scaleFactor, scaleFactor, bugAngle, 0);
+            // Back to normal drawing
+            endShadows();
+        }
 
-        // Restore normal blender
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+        // Add heading bug
+        drawScaledRotatedBitmap(bitmaps[4], 40, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, bugAngle, 0);
     }
 
-    // Add heading bug
-    al_draw_scaled_rotated_bitmap(bitmaps[4], 40, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, bugAngle, 0);
-
-    al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
-
-    if (!globals.active) {
-        dimInstrument();
-    }
+    endRender(!globals.active);
 }
 
 /// <summary>
@@ -125,7 +122,7 @@ void hi::update()
     xPos = settings[0];
     yPos = settings[1];
 
-    if (size != settings[2]) {
+    if (sizeChanged(settings[2])) {
         size = settings[2];
         resize();
     }
@@ -138,7 +135,7 @@ void hi::update()
 #endif
 
     // Get latest FlightSim variables
-    SimVars* simVars = &globals.simVars->simVars;
+    SimVars* simVars = globals.simVars->simVars;
 
     // Calculate values
     angle = -simVars->hiHeading * DegreesToRadians;
@@ -7,7 +7,6 @@ nav::nav(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
     setName("Nav");
     addVars();
-    simVars = &globals.simVars->simVars;
 
 #ifndef _WIN32
     // Only have hardware knobs on Raspberry Pi
@@ -16,6 +15,31 @@ nav::nav(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
     }
 #endif
 
+    // Values that change how the instrument looks
+    addState(&switchSel);
+    addState(&com1Freq);
+    addState(&com1Standby);
+    addState(&nav1Freq);
+    addState(&nav1Standby);
+    addState(&com2Freq);
+    addState(&com2Standby);
+    addState(&nav2Freq);
+    addState(&nav2Standby);
+    addState(&adfFreq);
+    addState(&adfStandby);
+    addState(&squawk);
+    addState(&transponderState);
+    addState(&autopilotSpd);
+    addState(&autopilotHdg);
+    addState(&autopilotAlt);
+    addState(&airspeed);
+    addState(&machX100);
+    addState(&heading);
+    addState(&altitude);
+    addState(&verticalSpeed);
+    addState(&autopilotEngaged);
+    addState(&showMach);
+
     resize();
 }
 
@@ -42,16 +66,10 @@ void nav::resize()
     addBitmap(bmp);
 
     // 2 = Main Nav
-    bmp = al_create_bitmap(size, size / 4);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 0, 0, 1600, 400, 0, 0, size, size / 4, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 0, 0, 1600, 400, size, size / 4));
 
     // 3 = Main Autopilot
-    bmp = al_create_bitmap(size, size / 4);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 0, 400, 1600, 400, 0, 0, size, size / 4, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 0, 400, 1600, 400, size, size / 4));
 
     // 4 = Digits
     bmp = al_create_bitmap(380, 80);
@@ -113,7 +131,7 @@ void nav::resize()
     al_draw_bitmap_region(orig, 1506, 880, 23, 50, 0, 0, 0);
     addBitmap(bmp);
 
-    al_set_target_backbuffer(globals.display);
+    al_set_target_bitmap(globals.screen);
 }
 
 /// <summary>
@@ -126,25 +144,21 @@ void nav::render()
     }
 
     // Use normal blender
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
-
-    // Draw stuff into dest bitmap
-    al_set_target_bitmap(bitmaps[1]);
+    setBlender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
 
-    if (switchSel < 6) {
-        renderNav();
-    }
-    else {
-        renderAutopilot();
+    // Draw stuff into dest bitmap (only if something has changed) or
+    // straight on screen
+    if (beginRender()) {
+        if (switchSel < 6) {
+            renderNav();
+        }
+        else {
+            renderAutopilot();
+        }
     }
 
-    // Position dest bitmap on screen
-    al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
-
-    if (!globals.active) {
-        dimInstrument();
-    }
+    // Position dest bitmap on screen (dimmed when not connected)
+    endRender(!globals.active);
 }
 
 /// <summary>
@@ -153,7 +167,7 @@ void nav::render()
 void nav::renderNav()
 {
     // Add main nav
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+    drawBitmap(bitmaps[2], 0, 0, 0);
 
     // Add panel 1 frequencies
     addFreq3dp(com1Freq, 237, 19);
@@ -168,28 +182,28 @@ void nav::renderNav()
     addFreq2dp(nav2Standby, 1153, 148);
 
     // Add panel 3 frequencies
-    addNum4(simVars->adfFreq, 273, 278);
-    addNum4(simVars->adfStandby, 586, 278);
+    addNum4(adfFreq, 273, 278);
+    addNum4(adfStandby, 586, 278);
 
     // Add squawk
-    addSquawk(simVars->transponderCode, 968, 278);
+    addSquawk(squawk, 968, 278);
 
     // Add selected switch
     switch (switchSel) {
     case 0:
-        al_draw_scaled_bitmap(bitmaps[6], 0, 0, 80, 34, 460 * scaleFactor, 104 * scaleFactor, 80 * scaleFactor, 34 * scaleFactor, 0);
+        drawScaledBitmap(bitmaps[6], 0, 0, 80, 34, 460 * scaleFactor, 104 * scaleFactor, 80 * scaleFactor, 34 * scaleFactor, 0);
         break;
     case 1:
-        al_draw_scaled_bitmap(bitmaps[6], 0, 0, 80, 34, 1064 * scaleFactor, 104 * scaleFactor, 80 * scaleFactor, 34 * scaleFactor, 0);
+        drawScaledBitmap(bitmaps[6], 0, 0, 80, 34, 1064 * scaleFactor, 104 * scaleFactor, 80 * scaleFactor, 34 * scaleFactor, 0);
         break;
     case 2:
-        al_draw_scaled_bitmap(bitmaps[6], 0, 0, 80, 34, 460 * scaleFactor, 233 * scaleFactor, 80 * scaleFactor, 34 * scaleFactor, 0);
+        drawScaledBitmap(bitmaps[6], 0, 0, 80, 34, 460 * scaleFactor, 233 * scaleFactor, 80 * scaleFactor, 34 * scaleFactor, 0);
         break;
     case 3:
-        al_draw_scaled_bitmap(bitmaps[6], 0, 0, 80, 34, 1064 * scaleFactor, 233 * scaleFactor, 80 * scaleFactor, 34 * scaleFactor, 0);
+        drawScaledBitmap(bitmaps[6], 0, 0, 80, 34, 1064 * scaleFactor, 233 * scaleFactor, 80 * scaleFactor, 34 * scaleFactor, 0);
         break;
     case 4:
-        al_draw_scaled_bitmap(bitmaps[6], 0, 0, 80, 34, 460 * scaleFactor, 363 * scaleFactor, 80 * scaleFactor, 34 * scaleFactor, 0);
+        drawScaledBitmap(bitmaps[6], 0, 0, 80, 34, 460 * scaleFactor, 363 * scaleFactor, 80 * scaleFactor, 34 * scaleFactor, 0);
         break;
     }
 
@@ -197,11 +211,11 @@ void nav::renderNav()
     int statePos = 80 * transponderState;
     if (switchSel == 5) {
         // Add transponder state selected
-        al_draw_scaled_bitmap(bitmaps[7], statePos, 0, 80, 34, 1064 * scaleFactor, 363 * scaleFactor, 80 * scaleFactor, 34 * scaleFactor, 0);
+        drawScaledBitmap(bitmaps[7], statePos, 0, 80, 34, 1064 * scaleFactor, 363 * scaleFactor, 80 * scaleFactor, 34 * scaleFactor, 0);
     }
     else {
         // Add transponder state
-        al_draw_scaled_bitmap(bitmaps[8], statePos, 0, 80, 34, 1064 * scaleFactor, 363 * scaleFactor, 80 * scaleFactor, 34 * scaleFactor, 0);
+        drawScaledBitmap(bitmaps[8], statePos, 0, 80, 34, 1064 * scaleFactor, 363 * scaleFactor, 80 * scaleFactor, 34 * scaleFactor, 0);
     }
 }
 
@@ -211,12 +225,12 @@ void nav::renderNav()
 void nav::renderAutopilot()
 {
     // Add main autopilot
-    al_draw_bitmap(bitmaps[3], 0, 0, 0);
+    drawBitmap(bitmaps[3], 0, 0, 0);
 
     // Add autopilot switch selected
     int selPos = 80 * (switchSel - 6);
     int destPos = 443 + 160 * (switchSel - 6);
-    al_draw_scaled_bitmap(bitmaps[9], selPos, 0, 80, 34, destPos * scaleFactor, 340 * scaleFactor, 80 * scaleFactor, 34 * scaleFactor, 0);
+    drawScaledBitmap(bitmaps[9], selPos, 0, 80, 34, destPos * scaleFactor, 340 * scaleFactor, 80 * scaleFactor, 34 * scaleFactor, 0);
 
     int destSizeX = 128 * scaleFactor;
     int destSizeY = 50 * scaleFactor;
@@ -236,41 +250,41 @@ void nav::renderAutopilot()
     // Add hdg display
     switch (autopilotHdg) {
     case HdgSet:
-        al_draw_scaled_bitmap(bitmaps[10], 0, 0, 128, 50, 385 * scaleFactor, 252 * scaleFactor, destSizeX, destSizeY, 0);
+        drawScaledBitmap(bitmaps[10], 0, 0, 128, 50, 385 * scaleFactor, 252 * scaleFactor, destSizeX, destSizeY, 0);
         break;
     case LevelFlight:
-        al_draw_scaled_bitmap(bitmaps[10], 128, 0, 128, 50, 385 * scaleFactor, 252 * scaleFactor, destSizeX, destSizeY, 0);
+        drawScaledBitmap(bitmaps[10], 128, 0, 128, 50, 385 * scaleFactor, 252 * scaleFactor, destSizeX, destSizeY, 0);
         break;
     }
 
     // Add ap display
-    if (simVars->autopilotEngaged) {
-        al_draw_scaled_bitmap(bitmaps[10], 256, 0, 128, 50, 530 * scaleFactor, 252 * scaleFactor, destSizeX, destSizeY, 0);
+    if (autopilotEngaged) {
+        drawScaledBitmap(bitmaps[10], 256, 0, 128, 50, 530 * scaleFactor, 252 * scaleFactor, destSizeX, destSizeY, 0);
     }
 
     // Add alt display
     switch (autopilotAlt) {
     case AltHold:
-        al_draw_scaled_bitmap(bitmaps[10], 384, 0, 128, 50, 680 * scaleFactor, 252 * scaleFactor, destSizeX, destSizeY, 0);
+        drawScaledBitmap(bitmaps[10], 384, 0, 128, 50, 680 * scaleFactor, 252 * scaleFactor, destSizeX, destSizeY, 0);
         break;
     case PitchHold:
-        al_draw_scaled_bitmap(bitmaps[10], 512, 0, 128, 50, 680 * scaleFactor, 252 * scaleFactor, destSizeX, destSizeY, 0);
+        drawScaledBitmap(bitmaps[10], 512, 0, 128, 50, 680 * scaleFactor, 252 * scaleFactor, destSizeX, destSizeY, 0);
         break;
     case VerticalSpeedHold:
     {
-        al_draw_scaled_bitmap(bitmaps[10], 640, 0, 128, 50, 680 * scaleFactor, 252 * scaleFactor, destSizeX, destSizeY, 0);
+        drawScaledBitmap(bitmaps[10], 640, 0, 128, 50, 680 * scaleFactor, 252 * scaleFactor, destSizeX, destSizeY, 0);
         addVerticalSpeed(836, 252);
         // Add white alts display
-        al_draw_scaled_bitmap(bitmaps[10], 896, 0, 128, 50, 1115 * scaleFactor, 252 * scaleFactor, destSizeX, destSizeY, 0);
+        drawScaledBitmap(bitmaps[10], 896, 0, 128, 50, 1115 * scaleFactor, 252 * scaleFactor, destSizeX, destSizeY, 0);
         break;
     }
     case AltChange:
         // ALT
-        al_draw_scaled_bitmap(bitmaps[10], 384, 0, 128, 50, 680 * scaleFactor, 252 * scaleFactor, destSizeX, destSizeY, 0);
+        drawScaledBitmap(bitmaps[10], 384, 0, 128, 50, 680 * scaleFactor, 252 * scaleFactor, destSizeX, destSizeY, 0);
         // + S = ALTS
-        al_draw_scaled_bitmap(bitmaps[10], 692, 0, 32, 50, 788 * scaleFactor, 252 * scaleFactor, 32 * scaleFactor, destSizeY, 0);
+        drawScaledBitmap(bitmaps[10], 692, 0, 32, 50, 788 * scaleFactor, 252 * scaleFactor, 32 * scaleFactor, destSizeY, 0);
         // Add white alt display
-        al_draw_scaled_bitmap(bitmaps[10], 896, 0, 94, 50, 1115 * scaleFactor, 252 * scaleFactor, 94 * scaleFactor, destSizeY, 0);
+        drawScaledBitmap(bitmaps[10], 896, 0, 94, 50, 1115 * scaleFactor, 252 * scaleFactor, 94 * scaleFactor, destSizeY, 0);
         break;
     }
 }
@@ -288,9 +302,9 @@ void nav::addNum3(int val, int x, int y)
     int width = 38 * scaleFactor;
     int height = 80 * scaleFactor;
 
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit1, 0, 38, 80, x * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit2, 0, 38, 80, (x + 38) * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit3, 0, 38, 80, (x + 76) * scaleFactor, yPos, width, height, 0);
+    drawScaledBitmap(bitmaps[4], 38 * digit1, 0, 38, 80, x * scaleFactor, yPos, width, height, 0);
+    drawScaledBitmap(bitmaps[4], 38 * digit2, 0, 38, 80, (x + 38) * scaleFactor, yPos, width, height, 0);
+    drawScaledBitmap(bitmaps[4], 38 * digit3, 0, 38, 80, (x + 76) * scaleFactor, yPos, width, height, 0);
 }
 
 /// <summary>
@@ -312,17 +326,17 @@ void nav::addNum4(int val, int x, int y, bool leading)
     int height = 80 * scaleFactor;
 
     if (leading || digit1 != 0) {
-        al_draw_scaled_bitmap(bitmaps[4], 38 * digit1, 0, 38, 80, x * scaleFactor, yPos, width, height, 0);
+        drawScaledBitmap(bitmaps[4], 38 * digit1, 0, 38, 80, x * scaleFactor, yPos, width, height, 0);
     }
     x += 38;
 
     if (leading || digit1 != 0 || digit2 != 0) {
-        al_draw_scaled_bitmap(bitmaps[4], 38 * digit2, 0, 38, 80, x * scaleFactor, yPos, width, height, 0);
+        drawScaledBitmap(bitmaps[4], 38 * digit2, 0, 38, 80, x * scaleFactor, yPos, width, height, 0);
     }
     x += 38;
 
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit3, 0, 38, 80, x * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit4, 0, 38, 80, (x + 38) * scaleFactor, yPos, width, height, 0);
+    drawScaledBitmap(bitmaps[4], 38 * digit3, 0, 38, 80, x * scaleFactor, yPos, width, height, 0);
+    drawScaledBitmap(bitmaps[4], 38 * digit4, 0, 38, 80, (x + 38) * scaleFactor, yPos, width, height, 0);
 }
 
 /// <summary>
@@ -345,18 +359,18 @@ void nav::addNum5(int val, int x, int y, bool leading)
     int height = 80 * scaleFactor;
 
     if (leading || digit1 != 0) {
-        al_draw_scaled_bitmap(bitmaps[4], 38 * digit1, 0, 38, 80, x * scaleFactor, yPos, width, height, 0);
+        drawScaledBitmap(bitmaps[4], 38 * digit1, 0, 38, 80, x * scaleFactor, yPos, width, height, 0);
     }
     x += 38;
 
     if (leading || digit1 != 0 || digit2 != 0) {
-        al_draw_scaled_bitmap(bitmaps[4], 38 * digit2, 0, 38, 80, x * scaleFactor, yPos, width, height, 0);
+        drawScaledBitmap(bitmaps[4], 38 * digit2, 0, 38, 80, x * scaleFactor, yPos, width, height, 0);
     }
     x += 38;
 
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit3, 0, 38, 80, x * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit4, 0, 38, 80, (x + 38) * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit5, 0, 38, 80, (x + 76) * scaleFactor, yPos, width, height, 0);
+    drawScaledBitmap(bitmaps[4], 38 * digit3, 0, 38, 80, x * scaleFactor, yPos, width, height, 0);
+    drawScaledBitmap(bitmaps[4], 38 * digit4, 0, 38, 80, (x + 38) * scaleFactor, yPos, width, height, 0);
+    drawScaledBitmap(bitmaps[4], 38 * digit5, 0, 38, 80, (x + 76) * scaleFactor, yPos, width, height, 0);
 }
 
 /// <summary>
@@ -372,10 +386,10 @@ void nav::addNum2dp(int val, int x, int y)
     int width = 38 * scaleFactor;
     int height = 80 * scaleFactor;
 
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit1, 0, 38, 80, x * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[5], 0, 0, 20, 80, (x + 38) * scaleFactor, yPos, 20 * scaleFactor, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit2, 0, 38, 80, (x + 58) * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit3, 0, 38, 80, (x + 96) * scaleFactor, yPos, width, height, 0);
+    drawScaledBitmap(bitmaps[4], 38 * digit1, 0, 38, 80, x * scaleFactor, yPos, width, height, 0);
+    drawScaledBitmap(bitmaps[5], 0, 0, 20, 80, (x + 38) * scaleFactor, yPos, 20 * scaleFactor, height, 0);
+    drawScaledBitmap(bitmaps[4], 38 * digit2, 0, 38, 80, (x + 58) * scaleFactor, yPos, width, height, 0);
+    drawScaledBitmap(bitmaps[4], 38 * digit3, 0, 38, 80, (x + 96) * scaleFactor, yPos, width, height, 0);
 }
 
 /// <summary>
@@ -393,12 +407,12 @@ void nav::addFreq2dp(int freq, int x, int y)
     int width = 38 * scaleFactor;
     int height = 80 * scaleFactor;
 
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit1, 0, 38, 80, x * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit2, 0, 38, 80, (x + 38) * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit3, 0, 38, 80, (x + 76) * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[5], 0, 0, 20, 80, (x + 114) * scaleFactor, yPos, 20 * scaleFactor, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit4, 0, 38, 80, (x + 134) * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit5, 0, 38, 80, (x + 172) * scaleFactor, yPos, width, height, 0);
+    drawScaledBitmap(bitmaps[4], 38 * digit1, 0, 38, 80, x * scaleFactor, yPos, width, height, 0);
+    drawScaledBitmap(bitmaps[4], 38 * digit2, 0, 38, 80, (x + 38) * scaleFactor, yPos, width, height, 0);
+    drawScaledBitmap(bitmaps[4], 38 * digit3, 0, 38, 80, (x + 76) * scaleFactor, yPos, width, height, 0);
+    drawScaledBitmap(bitmaps[5], 0, 0, 20, 80, (x + 114) * scaleFactor, yPos, 20 * scaleFactor, height, 0);
+    drawScaledBitmap(bitmaps[4], 38 * digit4, 0, 38, 80, (x + 134) * scaleFactor, yPos, width, height, 0);
+    drawScaledBitmap(bitmaps[4], 38 * digit5, 0, 38, 80, (x + 172) * scaleFactor, yPos, width, height, 0);
 }
 
 /// <summary>
@@ -417,13 +431,13 @@ void nav::addFreq3dp(int freq, int x, int y)
     int width = 38 * scaleFactor;
     int height = 80 * scaleFactor;
 
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit1, 0, 38, 80, x * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit2, 0, 38, 80, (x + 38) * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit3, 0, 38, 80, (x + 76) * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[5], 0, 0, 20, 80, (x + 114) * scaleFactor, yPos, 20 * scaleFactor, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit4, 0, 38, 80, (x + 134) * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit5, 0, 38, 80, (x + 172) * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit6, 0, 38, 80, (x + 210) * scaleFactor, yPos, width, height, 0);
+    drawScaledBitmap(bitmaps[4], 38 * digit1, 0, 38, 80, x * scaleFactor, yPos, width, height, 0);
+    drawScaledBitmap(bitmaps[4], 38 * digit2, 0, 38, 80, (x + 38) * scaleFactor, yPos, width, height, 0);
+    drawScaledBitmap(bitmaps[4], 38 * digit3, 0, 38, 80, (x + 76) * scaleFactor, yPos, width, height, 0);
+    drawScaledBitmap(bitmaps[5], 0, 0, 20, 80, (x + 114) * scaleFactor, yPos, 20 * scaleFactor, height, 0);
+    drawScaledBitmap(bitmaps[4], 38 * digit4, 0, 38, 80, (x + 134) * scaleFactor, yPos, width, height, 0);
+    drawScaledBitmap(bitmaps[4], 38 * digit5, 0, 38, 80, (x + 172) * scaleFactor, yPos, width, height, 0);
+    drawScaledBitmap(bitmaps[4], 38 * digit6, 0, 38, 80, (x + 210) * scaleFactor, yPos, width, height, 0);
 }
 
 /// <summary>
@@ -443,10 +457,10 @@ void nav::addSquawk(int code, int x, int y)
     int width = 38 * scaleFactor;
     int height = 80 * scaleFactor;
 
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit1, 0, 38, 80, x * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit2, 0, 38, 80, (x + 76) * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit3, 0, 38, 80, (x + 152) * scaleFactor, yPos, width, height, 0);
-    al_draw_scaled_bitmap(bitmaps[4], 38 * digit4, 0, 38, 80, (x + 228) * scaleFactor, yPos, width, height, 0);
+    drawScaledBitmap(bitmaps[4], 38 * digit1, 0, 38, 80, x * scaleFactor, yPos, width, height, 0);
+    drawScaledBitmap(bitmaps[4], 38 * digit2, 0, 38, 80, (x + 76) * scaleFactor, yPos, width, height, 0);
+    drawScaledBitmap(bitmaps[4], 38 * digit3, 0, 38, 80, (x + 152) * scaleFactor, yPos, width, height, 0);
+    drawScaledBitmap(bitmaps[4], 38 * digit4, 0, 38, 80, (x + 228) * scaleFactor, yPos, width, height, 0);
 }
 
 void nav::addVerticalSpeed(int x, int y)
@@ -454,14 +468,14 @@ void nav::addVerticalSpeed(int x, int y)
     int yPos = y * scaleFactor;
     int height = 50 * scaleFactor;
 
-    if (simVars->autopilotVerticalSpeed == 0) {
+    if (verticalSpeed == 0) {
         // Add 0fpm
         x += 87;
-        al_draw_scaled_bitmap(bitmaps[12], 32, 0, 130, 50, x * scaleFactor, yPos, 162 * scaleFactor, height, 0);
+        drawScaledBitmap(bitmaps[12], 32, 0, 130, 50, x * scaleFactor, yPos, 162 * scaleFactor, height, 0);
         return;
     }
 
-    int val = abs(simVars->autopilotVerticalSpeed);
+    int val = abs(verticalSpeed);
     int digit1 = (val % 10000) / 1000;
     int digit2 = (val % 1000) / 100;
 
@@ -469,22 +483,22 @@ void nav::addVerticalSpeed(int x, int y)
         x += 32;
     }
 
-    if (simVars->autopilotVerticalSpeed < 0) {
+    if (verticalSpeed < 0) {
         // Add minus
-        al_draw_scaled_bitmap(bitmaps[13], 0, 0, 23, 50, x * scaleFactor, yPos, 23 * scaleFactor, height, 0);
+        drawScaledBitmap(bitmaps[13], 0, 0, 23, 50, x * scaleFactor, yPos, 23 * scaleFactor, height, 0);
     }
     x += 23;
 
     if (digit1 != 0) {
-        al_draw_scaled_bitmap(bitmaps[11], 32 * digit1, 0, 32, 50, x * scaleFactor, yPos, 32 * scaleFactor, height, 0);
+        drawScaledBitmap(bitmaps[11], 32 * digit1, 0, 32, 50, x * scaleFactor, yPos, 32 * scaleFactor, height, 0);
         x += 32;
     }
 
-    al_draw_scaled_bitmap(bitmaps[11], 32 * digit2, 0, 32, 50, x * scaleFactor, yPos, 32 * scaleFactor, height, 0);
+    drawScaledBitmap(bitmaps[11], 32 * digit2, 0, 32, 50, x * scaleFactor, yPos, 32 * scaleFactor, height, 0);
     x += 32;
 
     // Add 00fpm
-    al_draw_scaled_bitmap(bitmaps[12], 0, 0, 162, 50, x * scaleFactor, yPos, 162 * scaleFactor, height, 0);
+    drawScaledBitmap(bitmaps[12], 0, 0, 162, 50, x * scaleFactor, yPos, 162 * scaleFactor, height, 0);
 }
 
 /// <summary>
@@ -499,11 +513,14 @@ void nav::update()
     xPos = settings[0];
     yPos = settings[1];
 
-    if (size != settings[2]) {
+    if (sizeChanged(settings[2])) {
         size = settings[2];
         resize();
     }
 
+    // Get latest FlightSim variables (snapshot changes every frame)
+    simVars = globals.simVars->simVars;
+
 #ifndef _WIN32
     // Only have hardware knobs on Raspberry Pi
     if (globals.hardwareKnobs) {
@@ -520,11 +537,16 @@ void nav::update()
     com2Standby = (simVars->com2Standby + 0.0000001) * 1000.0;
     nav2Freq = (simVars->nav2Freq + 0.0000001) * 100.0;
     nav2Standby = (simVars->nav2Standby + 0.0000001) * 100.0;
+    adfFreq = simVars->adfFreq;
+    adfStandby = simVars->adfStandby;
+    squawk = simVars->transponderCode;
 
     airspeed = simVars->autopilotAirspeed + 0.5;
     machX100 = simVars->autopilotMach * 100 + 0.5;
     heading = simVars->autopilotHeading + 0.5;
     altitude = simVars->autopilotAltitude + 0.5;
+    verticalSpeed = simVars->autopilotVerticalSpeed;
+    autopilotEngaged = (simVars->autopilotEngaged != 0);
 
     if (simVars->autopilotAirspeedHold == 1) {
         autopilotSpd = SpdHold;
@@ -595,6 +617,10 @@ void nav::addVars()
     globals.simVars->addVar(name, "Autopilot Airspeed Hold Var", false, 1, 0);
     globals.simVars->addVar(name, "Autopilot Mach Hold Var", false, 1, 0);
     globals.simVars->addVar(name, "Autopilot Airspeed Hold", false, 1, 0);
+
+    // Owned by other instruments
+    globals.simVars->useVar(name, "Airspeed Indicated");
+    globals.simVars->useVar(name, "Indicated Altitude");
 }
 
 #ifndef _WIN32
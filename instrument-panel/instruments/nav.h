@@ -40,6 +40,9 @@ private:
     int com2Standby;
     int nav2Freq;
     int nav2Standby;
+    int adfFreq;
+    int adfStandby;
+    int squawk;
     int transponderState = 3;
     AutopilotSpd autopilotSpd;
     AutopilotHdg autopilotHdg;
@@ -48,6 +51,8 @@ private:
     int machX100;
     int heading;
     int altitude;
+    int verticalSpeed;
+    bool autopilotEngaged;
     bool showMach = false;
 
     // Hardware knobs
@@ -8,9 +8,6 @@ class oil : public instrument
 private:
     float scaleFactor;
 
-    // Instrument values (caclulated from variables and needed to draw the instrument)
-    double angle;
-
 public:
     oil(int xPos, int yPos, int size);
     void render();
@@ -9,6 +9,15 @@ rpm::rpm(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
     setName("RPM");
     addVars();
+
+    // Values that change how the instrument looks
+    addState(&digit1);
+    addState(&digit2);
+    addState(&digit3);
+    addState(&digit4);
+    addState(&digit5);
+    addState(&angle);
+
     resize();
 }
 
@@ -35,10 +44,7 @@ void rpm::resize()
     addBitmap(bmp);
 
     // 2 = Main dial
-    bmp = al_create_bitmap(size, size);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 0, 0, 800, 800, 0, 0, size, size, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 0, 0, 800, 800, size, size));
 
     // 3 = Pointer
     bmp = al_create_bitmap(100, 600);
@@ -53,24 +59,15 @@ void rpm::resize()
     addBitmap(bmp);
 
     // 5 = White digits
-    bmp = al_create_bitmap(54 * scaleFactor, 594 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 1000, 0, 54, 594, 0, 0, 54 * scaleFactor, 594 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 1000, 0, 54, 594, 54 * scaleFactor, 594 * scaleFactor));
 
     // 6 = Black digits
-    bmp = al_create_bitmap(54 * scaleFactor, 594 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 1054, 0, 54, 594, 0, 0, 54 * scaleFactor, 594 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 1054, 0, 54, 594, 54 * scaleFactor, 594 * scaleFactor));
 
     // 7 = Hourglass
-    bmp = al_create_bitmap(54 * scaleFactor, 156 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 1108, 0, 54, 156, 0, 0, 54 * scaleFactor, 156 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 1108, 0, 54, 156, 54 * scaleFactor, 156 * scaleFactor));
 
-    al_set_target_backbuffer(globals.display);
+    al_set_target_bitmap(globals.screen);
 }
 
 /// <summary>
@@ -83,47 +80,43 @@ void rpm::render()
     }
 
     // Use normal blender
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+    setBlender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
 
-    // Draw stuff into dest bitmap
-    al_set_target_bitmap(bitmaps[1]);
+    // Draw stuff into dest bitmap (only if something has changed) or
+    // straight on screen
+    if (beginRender()) {
+        // Add white digits
+        drawBitmapRegion(bitmaps[5], 0, (499 - digit1 * 50.55) * scaleFactor, 54 * scaleFactor, 72 * scaleFactor, 238 * scaleFactor, 564 * scaleFactor, 0);
+        drawBitmapRegion(bitmaps[5], 0, (499 - digit2 * 50.55) * scaleFactor, 54 * scaleFactor, 72 * scaleFactor, 292 * scaleFactor, 564 * scaleFactor, 0);
+        drawBitmapRegion(bitmaps[5], 0, (499 - digit3 * 50.55) * scaleFactor, 54 * scaleFactor, 72 * scaleFactor, 346 * scaleFactor, 564 * scaleFactor, 0);
+        drawBitmapRegion(bitmaps[5], 0, (499 - digit4 * 50.55) * scaleFactor, 54 * scaleFactor, 72 * scaleFactor, 400 * scaleFactor, 564 * scaleFactor, 0);
 
-    // Add white digits
-    al_draw_bitmap_region(bitmaps[5], 0, (499 - digit1 * 50.55) * scaleFactor, 54 * scaleFactor, 72 * scaleFactor, 238 * scaleFactor, 564 * scaleFactor, 0);
-    al_draw_bitmap_region(bitmaps[5], 0, (499 - digit2 * 50.55) * scaleFactor, 54 * scaleFactor, 72 * scaleFactor, 292 * scaleFactor, 564 * scaleFactor, 0);
-    al_draw_bitmap_region(bitmaps[5], 0, (499 - digit3 * 50.55) * scaleFactor, 54 * scaleFactor, 72 * scaleFactor, 346 * scaleFactor, 564 * scaleFactor, 0);
-    al_draw_bitmap_region(bitmaps[5], 0, (499 - digit4 * 50.55) * scaleFactor, 54 * scaleFactor, 72 * scaleFactor, 400 * scaleFactor, 564 * scaleFactor, 0);
+        // Add black digits
+        drawBitmapRegion(bitmaps[6], 0, (499 - digit5 * 50.6) * scaleFactor, 54 * scaleFactor, 72 * scaleFactor, 454 * scaleFactor, 564 * scaleFactor, 0);
 
-    // Add black digits
-    al_draw_bitmap_region(bitmaps[6], 0, (499 - digit5 * 50.6) * scaleFactor, 54 * scaleFactor, 72 * scaleFactor, 454 * scaleFactor, 564 * scaleFactor, 0);
+        // Add hourglass
+        drawBitmapRegion(bitmaps[7], 0, 44 * scaleFactor, 54 * scaleFactor, 72 * scaleFactor, 508 * scaleFactor, 564 * scaleFactor, 0);
 
-    // Add hourglass
-    al_draw_bitmap_region(bitmaps[7], 0, 44 * scaleFactor, 54 * scaleFactor, 72 * scaleFactor, 508 * scaleFactor, 564 * scaleFactor, 0);
+        // Add main dial
+        drawBitmap(bitmaps[2], 0, 0, 0);
 
-    // Add main dial
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+        if (globals.enableShadows) {
+            // Multiply (shades of grey darken, white has no effect)
+            beginShadows();
 
-    if (globals.enableShadows) {
-        // Set blender to multiply (shades of grey darken, white has no effect)
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
+            // Add pointer shadow
+            drawScaledRotatedBitmap(bitmaps[4], 50, 400, 415 * scaleFactor, 415 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
 
-        // Add pointer shadow
-        al_draw_scaled_rotated_bitmap(bitmaps[4], 50, 400, 415 * scaleFactor, 415 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
+            // Back to normal drawing
+            endShadows();
+        }
 
-        // Restore normal blender
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+        // Add pointer
+        drawScaledRotatedBitmap(bitmaps[3], 50, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
     }
 
-    // Add pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[3], 50, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle * DegreesToRadians, 0);
-
-    // Position dest bitmap on screen
-    al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
-
-    if (!globals.active) {
-        dimInstrument();
-    }
+    // Position dest bitmap on screen (dimmed when not connected)
+    endRender(!globals.active);
 }
 
 /// <summary>
@@ -138,13 +131,13 @@ void rpm::update()
     xPos = settings[0];
     yPos = settings[1];
 
-    if (size != settings[2]) {
+    if (sizeChanged(settings[2])) {
         size = settings[2];
         resize();
     }
 
     // Get latest FlightSim variables
-    SimVars* simVars = &globals.simVars->simVars;
+    SimVars* simVars = globals.simVars->simVars;
 
     // Calculate values
     digit1 = ((int)simVars->rpmElapsedTime % 10000) / 1000;
@@ -7,6 +7,11 @@ tc::tc(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
     setName("TC");
     addVars();
+
+    // Values that change how the instrument looks
+    addState(&planeAngle);
+    addState(&ballAngle);
+
     resize();
 }
 
@@ -33,10 +38,7 @@ void tc::resize()
     addBitmap(bmp);
 
     // 2 = Main dial
-    bmp = al_create_bitmap(size, size);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 0, 0, 800, 800, 0, 0, size, size, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 0, 0, 800, 800, size, size));
 
     // 3 = Plane
     bmp = al_create_bitmap(800, 300);
@@ -62,7 +64,7 @@ void tc::resize()
     al_draw_scaled_bitmap(orig, 800, 748, 800, 130, 0, 0, size, 130 * scaleFactor, 0);
     addBitmap(bmp);
 
-    al_set_target_backbuffer(globals.display);
+    al_set_target_bitmap(globals.screen);
 }
 
 /// <summary>
@@ -70,46 +72,45 @@ void tc::resize()
 /// </summary>
 void tc::render()
 {
+    // Draw needles part way between their last two steps
+    ballAngle = interpolate(prevBall, stepBall);
+
     if (bitmaps[0] == NULL) {
         return;
     }
 
     // Use normal blender
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+    setBlender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
 
-    // Draw stuff into dest bitmap
-    al_set_target_bitmap(bitmaps[1]);
+    // Draw stuff into dest bitmap (only if something has changed) or
+    // straight on screen
+    if (beginRender()) {
+        // Add main dial
+        drawBitmap(bitmaps[2], 0, 0, 0);
 
-    // Add main dial
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+        // Add ball at offscreen centre 400, -550 (-651 orig)
+        drawScaledRotatedBitmap(bitmaps[5], 1100, 74, 400 * scaleFactor, -452 * scaleFactor, scaleFactor, scaleFactor, ballAngle * AngleFactor, 0);
 
-    // Add ball at offscreen centre 400, -550 (-651 orig)
-    al_draw_scaled_rotated_bitmap(bitmaps[5], 1100, 74, 400 * scaleFactor, -452 * scaleFactor, scaleFactor, scaleFactor, ballAngle * AngleFactor, 0);
+        // Add outer case
+        drawBitmap(bitmaps[6], 0, 494 * scaleFactor, 0);
 
-    // Add outer case
-    al_draw_bitmap(bitmaps[6], 0, 494 * scaleFactor, 0);
+        if (globals.enableShadows) {
+            // Multiply (shades of grey darken, white has no effect)
+            beginShadows();
 
-    if (globals.enableShadows) {
-        // Set blender to multiply (shades of grey darken, white has no effect)
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
+            // Add plane shadow
+            drawScaledRotatedBitmap(bitmaps[4], 400, 150, 415 * scaleFactor, 415 * scaleFactor, scaleFactor, scaleFactor, planeAngle * AngleFactor, 0);
 
-        // Add plane shadow
-        al_draw_scaled_rotated_bitmap(bitmaps[4], 400, 150, 415 * scaleFactor, 415 * scaleFactor, scaleFactor, scaleFactor, planeAngle * AngleFactor, 0);
+            // Back to normal drawing
+            endShadows();
+        }
 
-        // Restore normal blender
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+        // Add plane
+        drawScaledRotatedBitmap(bitmaps[3], 400, 150, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, planeAngle * AngleFactor, 0);
     }
 
-    // Add plane
-    al_draw_scaled_rotated_bitmap(bitmaps[3], 400, 150, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, planeAngle * AngleFactor, 0);
-
-        // Position dest bitmap on screen
-    al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
-
-    if (!globals.active) {
-        dimInstrument();
-    }
+    // Position dest bitmap on screen (dimmed when not connected)
+    endRender(!globals.active);
 }
 
 /// <summary>
@@ -124,13 +125,13 @@ void tc::update()
     xPos = settings[0];
     yPos = settings[1];
 
-    if (size != settings[2]) {
+    if (sizeChanged(settings[2])) {
         size = settings[2];
         resize();
     }
 
     // Get latest FlightSim variables
-    SimVars* simVars = &globals.simVars->simVars;
+    SimVars* simVars = globals.simVars->simVars;
 
     // Calculate values
     planeAngle = simVars->tcRate * 200;
@@ -141,37 +142,48 @@ void tc::update()
     else if (planeAngle > 23) {
         planeAngle = 23;
     }
+}
+
+/// <summary>
+/// Move needles one fixed step towards the latest FlightSim values
+/// </summary>
+void tc::step()
+{
+    // Get latest FlightSim variables
+    SimVars* simVars = globals.simVars->simVars;
+
+    prevBall = stepBall;
 
     // Need to turn ball by -90 degrees = -64
     targetAngle = (-simVars->tcBall * 9) - 64.0;
 
-    double diff = abs(targetAngle - ballAngle);
+    double diff = abs(targetAngle - stepBall);
 
     if (diff > 20.0) {
-        if (ballAngle < targetAngle) ballAngle += 4.0; else ballAngle -= 4.0;
+        if (stepBall < targetAngle) stepBall += 4.0; else stepBall -= 4.0;
     }
     else if (diff > 10.0) {
-        if (ballAngle < targetAngle) ballAngle += 2.0; else ballAngle -= 2.0;
+        if (stepBall < targetAngle) stepBall += 2.0; else stepBall -= 2.0;
     }
     else if (diff > 5.0) {
-        if (ballAngle < targetAngle) ballAngle += 1.0; else ballAngle -= 1.0;
+        if (stepBall < targetAngle) stepBall += 1.0; else stepBall -= 1.0;
     }
     else if (diff > 2.5) {
-        if (ballAngle < targetAngle) ballAngle += 0.5; else ballAngle -= 0.5;
+        if (stepBall < targetAngle) stepBall += 0.5; else stepBall -= 0.5;
     }
     else if (diff > 0.25) {
-        if (ballAngle < targetAngle) ballAngle += 0.25; else ballAngle -= 0.25;
+        if (stepBall < targetAngle) stepBall += 0.25; else stepBall -= 0.25;
     }
     else {
-        ballAngle = targetAngle;
+        stepBall = targetAngle;
     }
 
     // Hard stop at edge
-    if (ballAngle < -73.5) {
-        ballAngle = -73.5;
+    if (stepBall < -73.5) {
+        stepBall = -73.5;
     }
-    else if (ballAngle > -54.5) {
-        ballAngle = -54.5;
+    else if (stepBall > -54.5) {
+        stepBall = -54.5;
     }
 }
 
@@ -11,12 +11,15 @@ private:
     // Instrument values (caclulated from variables and needed to draw the instrument)
     double planeAngle = 0;
     double ballAngle = -64;      // Need to turn -90 degrees
+    double stepBall = -64;
+    double prevBall = -64;
     double targetAngle;
 
 public:
     tc(int xPos, int yPos, int size);
     void render();
     void update();
+    void step();
 
 private:
     void resize();
@@ -16,6 +16,16 @@ trimFlaps::trimFlaps(int xPos, int yPos, int size) : instrument(xPos, yPos, size
     }
 #endif
 
+    // Values that change how the instrument looks
+    addState(&trimOffset);
+    addState(&flapsOffset);
+    addState(&targetFlaps);
+    addState(&isGearRetractable);
+    addState(&gearLeftPos);
+    addState(&gearCentrePos);
+    addState(&gearRightPos);
+    addState(&parkingBrakeOn);
+
     resize();
 }
 
@@ -42,28 +52,16 @@ void trimFlaps::resize()
     addBitmap(bmp);
 
     // 2 = Main panel
-    bmp = al_create_bitmap(size, size);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 0, 0, 800, 800, 0, 0, size, size, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 0, 0, 800, 800, size, size));
 
     // 3 = Trim
-    bmp = al_create_bitmap(40 * scaleFactor, 24 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 800, 0, 40, 24, 0, 0, 40 * scaleFactor, 24 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 800, 0, 40, 24, 40 * scaleFactor, 24 * scaleFactor));
 
     // 4 = Flaps
-    bmp = al_create_bitmap(36 * scaleFactor, 36 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 800, 24, 36, 36, 0, 0, 36 * scaleFactor, 36 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 800, 24, 36, 36, 36 * scaleFactor, 36 * scaleFactor));
 
     // 5 = Flaps target
-    bmp = al_create_bitmap(36 * scaleFactor, 36 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 800, 60, 36, 36, 0, 0, 36 * scaleFactor, 36 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 800, 60, 36, 36, 36 * scaleFactor, 36 * scaleFactor));
 
     // 6 = Landing gear
     bmp = al_create_bitmap(198, 44);
@@ -89,7 +87,7 @@ void trimFlaps::resize()
     al_draw_bitmap_region(orig, 392, 800, 251, 44, 0, 0, 0);
     addBitmap(bmp);
 
-    al_set_target_backbuffer(globals.display);
+    al_set_target_bitmap(globals.screen);
 }
 
 /// <summary>
@@ -97,71 +95,70 @@ void trimFlaps::resize()
 /// </summary>
 void trimFlaps::render()
 {
+    // Draw needles part way between their last two steps
+    flapsOffset = interpolate(prevFlaps, stepFlaps);
+
     if (bitmaps[0] == NULL) {
         return;
     }
 
     // Use normal blender
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+    setBlender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
 
-    // Draw stuff into dest bitmap
-    al_set_target_bitmap(bitmaps[1]);
+    // Draw stuff into dest bitmap (only if something has changed) or
+    // straight on screen
+    if (beginRender()) {
+        // Add main panel
+        drawBitmap(bitmaps[2], 0, 0, 0);
 
-    // Add main panel
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+        // Add trim
+        drawBitmap(bitmaps[3], 262 * scaleFactor, (301 + trimOffset) * scaleFactor, 0);
 
-    // Add trim
-    al_draw_bitmap(bitmaps[3], 262 * scaleFactor, (301 + trimOffset) * scaleFactor, 0);
+        // Add flaps target
+        drawBitmap(bitmaps[5], 501 * scaleFactor, (161 + targetFlaps) * scaleFactor, 0);
 
-    // Add flaps target
-    al_draw_bitmap(bitmaps[5], 501 * scaleFactor, (161 + targetFlaps) * scaleFactor, 0);
+        // Add flaps
+        drawBitmap(bitmaps[4], 501 * scaleFactor, (161 + flapsOffset) * scaleFactor, 0);
 
-    // Add flaps
-    al_draw_bitmap(bitmaps[4], 501 * scaleFactor, (161 + flapsOffset) * scaleFactor, 0);
+        if (isGearRetractable) {
+            // Add landing gear
+            drawScaledBitmap(bitmaps[6], 0, 0, 198, 44, 227 * scaleFactor, 535 * scaleFactor, 198 * scaleFactor, 44 * scaleFactor, 0);
 
-    if (isGearRetractable) {
-        // Add landing gear
-        al_draw_scaled_bitmap(bitmaps[6], 0, 0, 198, 44, 227 * scaleFactor, 535 * scaleFactor, 198 * scaleFactor, 44 * scaleFactor, 0);
+            if (gearLeftPos == 100) {
+                // Add gear down
+                drawScaledBitmap(bitmaps[8], 0, 0, 90, 70, 223 * scaleFactor, 590 * scaleFactor, 90 * scaleFactor, 70 * scaleFactor, 0);
+            }
+            else if (gearLeftPos > 0) {
+                // Add UNLK
+                drawScaledBitmap(bitmaps[7], 0, 0, 104, 37, 214 * scaleFactor, 602 * scaleFactor, 104 * scaleFactor, 37 * scaleFactor, 0);
+            }
 
-        if (gearLeftPos == 100) {
-            // Add gear down
-            al_draw_scaled_bitmap(bitmaps[8], 0, 0, 90, 70, 223 * scaleFactor, 590 * scaleFactor, 90 * scaleFactor, 70 * scaleFactor, 0);
-        }
-        else if (gearLeftPos > 0) {
-            // Add UNLK
-            al_draw_scaled_bitmap(bitmaps[7], 0, 0, 104, 37, 214 * scaleFactor, 602 * scaleFactor, 104 * scaleFactor, 37 * scaleFactor, 0);
-        }
+            if (gearCentrePos == 100) {
+                // Add gear down
+                drawScaledBitmap(bitmaps[8], 0, 0, 90, 70, 358 * scaleFactor, 590 * scaleFactor, 90 * scaleFactor, 70 * scaleFactor, 0);
+            }
+            else if (gearCentrePos > 0) {
+                // Add UNLK
+                drawScaledBitmap(bitmaps[7], 0, 0, 104, 37, 350 * scaleFactor, 602 * scaleFactor, 104 * scaleFactor, 37 * scaleFactor, 0);
+            }
 
-        if (gearCentrePos == 100) {
-            // Add gear down
-            al_draw_scaled_bitmap(bitmaps[8], 0, 0, 90, 70, 358 * scaleFactor, 590 * scaleFactor, 90 * scaleFactor, 70 * scaleFactor, 0);
-        }
-        else if (gearCentrePos > 0) {
-            // Add UNLK
-            al_draw_scaled_bitmap(bitmaps[7], 0, 0, 104, 37, 350 * scaleFactor, 602 * scaleFactor, 104 * scaleFactor, 37 * scaleFactor, 0);
+            if (gearRightPos == 100) {
+                // Add gear down
+                drawScaledBitmap(bitmaps[8], 0, 0, 90, 70, 493 * scaleFactor, 590 * scaleFactor, 90 * scaleFactor, 70 * scaleFactor, 0);
+            }
+            else if (gearRightPos > 0) {
+                // Add UNLK
+                drawScaledBitmap(bitmaps[7], 0, 0, 104, 37, 486 * scaleFactor, 602 * scaleFactor, 104 * scaleFactor, 37 * scaleFactor, 0);
+            }
         }
 
-        if (gearRightPos == 100) {
-            // Add gear down
-            al_draw_scaled_bitmap(bitmaps[8], 0, 0, 90, 70, 493 * scaleFactor, 590 * scaleFactor, 90 * scaleFactor, 70 * scaleFactor, 0);
-        }
-        else if (gearRightPos > 0) {
-            // Add UNLK
-            al_draw_scaled_bitmap(bitmaps[7], 0, 0, 104, 37, 486 * scaleFactor, 602 * scaleFactor, 104 * scaleFactor, 37 * scaleFactor, 0);
+        if (parkingBrakeOn) {
+            // Add parking brake
+            drawScaledBitmap(bitmaps[9], 0, 0, 251, 44, 277 * scaleFactor, 692 * scaleFactor, 254 * scaleFactor, 44 * scaleFactor, 0);
         }
     }
 
-    if (parkingBrakeOn) {
-        // Add parking brake
-        al_draw_scaled_bitmap(bitmaps[9], 0, 0, 251, 44, 277 * scaleFactor, 692 * scaleFactor, 254 * scaleFactor, 44 * scaleFactor, 0);
-    }
-
-    al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
-
-    if (!globals.active) {
-        dimInstrument();
-    }
+    endRender(!globals.active);
 }
 
 /// <summary>
@@ -176,7 +173,7 @@ void trimFlaps::update()
     xPos = settings[0];
     yPos = settings[1];
 
-    if (size != settings[2]) {
+    if (sizeChanged(settings[2])) {
         size = settings[2];
         resize();
     }
@@ -189,7 +186,7 @@ void trimFlaps::update()
 #endif
 
     // Get latest FlightSim variables
-    SimVars* simVars = &globals.simVars->simVars;
+    SimVars* simVars = globals.simVars->simVars;
 
     // Calculate values
     trimOffset = simVars->tfElevatorTrim * 20.0;
@@ -203,23 +200,31 @@ void trimFlaps::update()
 
     targetFlaps = 345.0 * simVars->tfFlapsIndex / simVars->tfFlapsCount;
 
-    double diff = abs(targetFlaps - flapsOffset);
+    isGearRetractable = (simVars->gearRetractable == 1);
+    gearLeftPos = simVars->gearLeftPos;
+    gearCentrePos = simVars->gearCentrePos;
+    gearRightPos = simVars->gearRightPos;
+    parkingBrakeOn = (simVars->parkingBrakeOn == 1);
+}
+
+/// <summary>
+/// Move needles one fixed step towards the latest FlightSim values
+/// </summary>
+void trimFlaps::step()
+{
+    prevFlaps = stepFlaps;
+
+    double diff = abs(targetFlaps - stepFlaps);
 
     if (diff > 5.0) {
-        if (flapsOffset < targetFlaps) flapsOffset += 2.5; else flapsOffset -= 2.5;
+        if (stepFlaps < targetFlaps) stepFlaps += 2.5; else stepFlaps -= 2.5;
     }
     else if (diff > 1.25) {
-        if (flapsOffset < targetFlaps) flapsOffset += 1.25; else flapsOffset -= 1.25;
+        if (stepFlaps < targetFlaps) stepFlaps += 1.25; else stepFlaps -= 1.25;
     }
     else {
-        flapsOffset = targetFlaps;
+        stepFlaps = targetFlaps;
     }
-
-    isGearRetractable = (simVars->gearRetractable == 1);
-    gearLeftPos = simVars->gearLeftPos;
-    gearCentrePos = simVars->gearCentrePos;
-    gearRightPos = simVars->gearRightPos;
-    parkingBrakeOn = (simVars->parkingBrakeOn == 1);
 }
 
 /// <summary>
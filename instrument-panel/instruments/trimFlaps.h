@@ -11,7 +11,9 @@ private:
     // Instrument values (calculated from variables and needed to draw the instrument)
     float trimOffset;
     float flapsOffset = 0;
-    float targetFlaps;
+    float stepFlaps = 0;
+    float prevFlaps = 0;
+    float targetFlaps = 0;
     bool isGearRetractable;
     int gearLeftPos;
     int gearCentrePos;
@@ -29,6 +31,7 @@ public:
     trimFlaps(int xPos, int yPos, int size);
     void render();
     void update();
+    void step();
 
 private:
     void resize();
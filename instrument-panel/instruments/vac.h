@@ -8,9 +8,6 @@ class vac : public instrument
 private:
     float scaleFactor;
 
-    // Instrument values (caclulated from variables and needed to draw the instrument)
-    double angle;
-
 public:
     vac(int xPos, int yPos, int size);
     void render();
@@ -16,6 +16,13 @@ vor1::vor1(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
     }
 #endif
 
+    // Values that change how the instrument looks
+    addState(&compassAngle);
+    addState(&locAngle);
+    addState(&slopeAngle);
+    addState(&toFromOn);
+    addState(&glideSlopeOn);
+
     resize();
 }
 
@@ -42,10 +49,7 @@ void vor1::resize()
     addBitmap(bmp);
 
     // 2 = Back
-    bmp = al_create_bitmap(size, size);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 0, 0, 800, 800, 0, 0, size, size, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 0, 0, 800, 800, size, size));
 
     // 3 = Compass
     bmp = al_create_bitmap(800, 800);
@@ -54,22 +58,13 @@ void vor1::resize()
     addBitmap(bmp);
 
     // 4 = Glide slope on
-    bmp = al_create_bitmap(100 * scaleFactor, 50 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 800, 800, 100, 50, 0, 0, 100 * scaleFactor, 50 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 800, 800, 100, 50, 100 * scaleFactor, 50 * scaleFactor));
 
     // 5 = From on
-    bmp = al_create_bitmap(100 * scaleFactor, 50 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 900, 800, 100, 50, 0, 0, 100 * scaleFactor, 50 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 900, 800, 100, 50, 100 * scaleFactor, 50 * scaleFactor));
 
     // 6 = To on
-    bmp = al_create_bitmap(100 * scaleFactor, 50 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 1000, 800, 100, 50, 0, 0, 100 * scaleFactor, 50 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 1000, 800, 100, 50, 100 * scaleFactor, 50 * scaleFactor));
 
     // 7 = Locator needle
     bmp = al_create_bitmap(30, 800);
@@ -84,18 +79,12 @@ void vor1::resize()
     addBitmap(bmp);
 
     // 9 = Top guide
-    bmp = al_create_bitmap(70 * scaleFactor, 180 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 1630, 0, 70, 180, 0, 0, 70 * scaleFactor, 180 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 1630, 0, 70, 180, 70 * scaleFactor, 180 * scaleFactor));
 
     // 10 = Bottom guide
-    bmp = al_create_bitmap(70 * scaleFactor, 180 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 1630, 180, 70, 180, 0, 0, 70 * scaleFactor, 180 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 1630, 180, 70, 180, 70 * scaleFactor, 180 * scaleFactor));
 
-    al_set_target_backbuffer(globals.display);
+    al_set_target_bitmap(globals.screen);
 }
 
 /// <summary>
@@ -108,49 +97,45 @@ void vor1::render()
     }
 
     // Use normal blender
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
-
-    // Draw stuff into dest bitmap
-    al_set_target_bitmap(bitmaps[1]);
-
-    // Add back
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+    setBlender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
 
-    // Add glide slope on
-    if (glideSlopeOn == 1) {
-        al_draw_bitmap(bitmaps[4], 490 * scaleFactor, 335 * scaleFactor, 0);
-    }
+    // Draw stuff into dest bitmap (only if something has changed) or
+    // straight on screen
+    if (beginRender()) {
+        // Add back
+        drawBitmap(bitmaps[2], 0, 0, 0);
 
-    // Add to/from on
-    if (toFromOn == 1) {
-        al_draw_bitmap(bitmaps[6], 350 * scaleFactor, 549 * scaleFactor, 0);
-    }
-    else if (toFromOn == 2) {
-        al_draw_bitmap(bitmaps[5], 350 * scaleFactor, 549 * scaleFactor, 0);
-    }
-
-    // Add locator needle
-    al_draw_scaled_rotated_bitmap(bitmaps[7], 15, 140, 400 * scaleFactor, 140 * scaleFactor, scaleFactor, scaleFactor, locAngle * DegreesToRadians, 0);
+        // Add glide slope on
+        if (glideSlopeOn == 1) {
+            drawBitmap(bitmaps[4], 490 * scaleFactor, 335 * scaleFactor, 0);
+        }
 
-    // Add glide slope needle
-    al_draw_scaled_rotated_bitmap(bitmaps[8], 140, 15, 140 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, slopeAngle * DegreesToRadians, 0);
+        // Add to/from on
+        if (toFromOn == 1) {
+            drawBitmap(bitmaps[6], 350 * scaleFactor, 549 * scaleFactor, 0);
+        }
+        else if (toFromOn == 2) {
+            drawBitmap(bitmaps[5], 350 * scaleFactor, 549 * scaleFactor, 0);
+        }
 
-    // Add compass
-    al_draw_scaled_rotated_bitmap(bitmaps[3], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, compassAngle * DegreesToRadians, 0);
+        // Add locator needle
+        drawScaledRotatedBitmap(bitmaps[7], 15, 140, 400 * scaleFactor, 140 * scaleFactor, scaleFactor, scaleFactor, locAngle * DegreesToRadians, 0);
 
-    // Add top guide
-    al_draw_bitmap(bitmaps[9], 365 * scaleFactor, 0, 0);
+        // Add glide slope needle
+        drawScaledRotatedBitmap(bitmaps[8], 140, 15, 140 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, slopeAngle * DegreesToRadians, 0);
 
-    // Add bottom guide
-    al_draw_bitmap(bitmaps[10], 365 * scaleFactor, 620 * scaleFactor, 0);
+        // Add compass
+        drawScaledRotatedBitmap(bitmaps[3], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, compassAngle * DegreesToRadians, 0);
 
-    // Position dest bitmap on screen
-    al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+        // Add top guide
+        drawBitmap(bitmaps[9], 365 * scaleFactor, 0, 0);
 
-    if (!globals.active) {
-        dimInstrument();
+        // Add bottom guide
+        drawBitmap(bitmaps[10], 365 * scaleFactor, 620 * scaleFactor, 0);
     }
+
+    // Position dest bitmap on screen (dimmed when not connected)
+    endRender(!globals.active);
 }
 
 /// <summary>
@@ -165,7 +150,7 @@ void vor1::update()
     xPos = settings[0];
     yPos = settings[1];
 
-    if (size != settings[2]) {
+    if (sizeChanged(settings[2])) {
         size = settings[2];
         resize();
     }
@@ -178,7 +163,7 @@ void vor1::update()
 #endif
 
     // Get latest FlightSim variables
-    SimVars* simVars = &globals.simVars->simVars;
+    SimVars* simVars = globals.simVars->simVars;
 
     // Calculate values
     compassAngle = -simVars->vor1Obs;
@@ -226,7 +211,7 @@ void vor1::updateKnobs()
         // Change Obs by knob movement amount (adjust for desired sensitivity)
         int adjust = (int)((val - prevVal) / 2) * 5;
         if (adjust != 0) {
-            double newVal = globals.simVars->simVars.vor1Obs + adjust;
+            double newVal = globals.simVars->simVars->vor1Obs + adjust;
 
             if (newVal < 0) {
                 newVal += 360;
@@ -16,6 +16,11 @@ vor2::vor2(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
     }
 #endif
 
+    // Values that change how the instrument looks
+    addState(&compassAngle);
+    addState(&locAngle);
+    addState(&toFromOn);
+
     resize();
 }
 
@@ -42,10 +47,7 @@ void vor2::resize()
     addBitmap(bmp);
 
     // 2 = Back
-    bmp = al_create_bitmap(size, size);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 0, 0, 800, 800, 0, 0, size, size, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 0, 0, 800, 800, size, size));
 
     // 3 = Compass
     bmp = al_create_bitmap(800, 800);
@@ -54,16 +56,10 @@ void vor2::resize()
     addBitmap(bmp);
 
     // 4 = From on
-    bmp = al_create_bitmap(100 * scaleFactor, 50 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 1600, 600, 100, 50, 0, 0, 100 * scaleFactor, 50 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 1600, 600, 100, 50, 100 * scaleFactor, 50 * scaleFactor));
 
     // 5 = To on
-    bmp = al_create_bitmap(100 * scaleFactor, 50 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 1600, 650, 100, 50, 0, 0, 100 * scaleFactor, 50 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 1600, 650, 100, 50, 100 * scaleFactor, 50 * scaleFactor));
 
     // 6 = Locator needle
     bmp = al_create_bitmap(30, 600);
@@ -72,18 +68,12 @@ void vor2::resize()
     addBitmap(bmp);
 
     // 7 = Top guide
-    bmp = al_create_bitmap(70 * scaleFactor, 180 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 1630, 0, 70, 180, 0, 0, 70 * scaleFactor, 180 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 1630, 0, 70, 180, 70 * scaleFactor, 180 * scaleFactor));
 
     // 8 = Bottom guide
-    bmp = al_create_bitmap(70 * scaleFactor, 180 * scaleFactor);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 1630, 180, 70, 180, 0, 0, 70 * scaleFactor, 180 * scaleFactor, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 1630, 180, 70, 180, 70 * scaleFactor, 180 * scaleFactor));
 
-    al_set_target_backbuffer(globals.display);
+    al_set_target_bitmap(globals.screen);
 }
 
 /// <summary>
@@ -96,41 +86,37 @@ void vor2::render()
     }
 
     // Use normal blender
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
-
-    // Draw stuff into dest bitmap
-    al_set_target_bitmap(bitmaps[1]);
-
-    // Add back
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+    setBlender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
 
-    // Add to/from on
-    if (toFromOn == 1) {
-        al_draw_bitmap(bitmaps[5], 478 * scaleFactor, 379 * scaleFactor, 0);
-    }
-    else if (toFromOn == 2) {
-        al_draw_bitmap(bitmaps[4], 478 * scaleFactor, 379 * scaleFactor, 0);
-    }
+    // Draw stuff into dest bitmap (only if something has changed) or
+    // straight on screen
+    if (beginRender()) {
+        // Add back
+        drawBitmap(bitmaps[2], 0, 0, 0);
 
-    // Add locator needle
-    al_draw_scaled_rotated_bitmap(bitmaps[6], 15, 125, 400 * scaleFactor, 125 * scaleFactor, scaleFactor, scaleFactor, locAngle * DegreesToRadians, 0);
-
-    // Add compass
-    al_draw_scaled_rotated_bitmap(bitmaps[3], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, compassAngle * DegreesToRadians, 0);
+        // Add to/from on
+        if (toFromOn == 1) {
+            drawBitmap(bitmaps[5], 478 * scaleFactor, 379 * scaleFactor, 0);
+        }
+        else if (toFromOn == 2) {
+            drawBitmap(bitmaps[4], 478 * scaleFactor, 379 * scaleFactor, 0);
+        }
 
-    // Add top guide
-    al_draw_bitmap(bitmaps[7], 365 * scaleFactor, 0, 0);
+        // Add locator needle
+        drawScaledRotatedBitmap(bitmaps[6], 15, 125, 400 * scaleFactor, 125 * scaleFactor, scaleFactor, scaleFactor, locAngle * DegreesToRadians, 0);
 
-    // Add bottom guide
-    al_draw_bitmap(bitmaps[8], 365 * scaleFactor, 620 * scaleFactor, 0);
+        // Add compass
+        drawScaledRotatedBitmap(bitmaps[3], 400, 400, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, compassAngle * DegreesToRadians, 0);
 
-    // Position dest bitmap on screen
-    al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
+        // Add top guide
+        drawBitmap(bitmaps[7], 365 * scaleFactor, 0, 0);
 
-    if (!globals.active) {
-        dimInstrument();
+        // Add bottom guide
+        drawBitmap(bitmaps[8], 365 * scaleFactor, 620 * scaleFactor, 0);
     }
+
+    // Position dest bitmap on screen (dimmed when not connected)
+    endRender(!globals.active);
 }
 
 /// <summary>
@@ -145,7 +131,7 @@ void vor2::update()
     xPos = settings[0];
     yPos = settings[1];
 
-    if (size != settings[2]) {
+    if (sizeChanged(settings[2])) {
         size = settings[2];
         resize();
     }
@@ -158,7 +144,7 @@ void vor2::update()
 #endif
 
     // Get latest FlightSim variables
-    SimVars* simVars = &globals.simVars->simVars;
+    SimVars* simVars = globals.simVars->simVars;
 
     // Calculate values
     compassAngle = -simVars->vor2Obs;
@@ -197,7 +183,7 @@ void vor2::updateKnobs()
         // Change Obs by knob movement amount (adjust for desired sensitivity)
         int adjust = (int)((val - prevVal) / 2) * 5;
         if (adjust != 0) {
-            double newVal = globals.simVars->simVars.vor2Obs + adjust;
+            double newVal = globals.simVars->simVars->vor2Obs + adjust;
 
             if (newVal < 0) {
                 newVal += 360;
@@ -8,6 +8,10 @@ vsi::vsi(int xPos, int yPos, int size) : instrument(xPos, yPos, size)
 {
     setName("VSI");
     addVars();
+
+    // Values that change how the instrument looks
+    addState(&angle);
+
     resize();
 }
 
@@ -34,10 +38,7 @@ void vsi::resize()
     addBitmap(bmp);
 
     // 2 = Main dial
-    bmp = al_create_bitmap(size, size);
-    al_set_target_bitmap(bmp);
-    al_draw_scaled_bitmap(orig, 0, 0, 800, 800, 0, 0, size, size, 0);
-    addBitmap(bmp);
+    addBitmap(bakeLayer(orig, 0, 0, 800, 800, size, size));
 
     // 3 = Pointer
     bmp = al_create_bitmap(800, 100);
@@ -51,7 +52,7 @@ void vsi::resize()
     al_draw_bitmap_region(orig, 0, 900, 800, 100, 0, 0, 0);
     addBitmap(bmp);
 
-    al_set_target_backbuffer(globals.display);
+    al_set_target_bitmap(globals.screen);
 }
 
 /// <summary>
@@ -59,40 +60,39 @@ void vsi::resize()
 /// </summary>
 void vsi::render()
 {
+    // Draw needles part way between their last two steps
+    angle = interpolate(prevAngle, stepAngle);
+
     if (bitmaps[0] == NULL) {
         return;
     }
 
     // Use normal blender
-    al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+    setBlender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
 
-    // Draw stuff into dest bitmap
-    al_set_target_bitmap(bitmaps[1]);
+    // Draw stuff into dest bitmap (only if something has changed) or
+    // straight on screen
+    if (beginRender()) {
+        // Add main dial
+        drawBitmap(bitmaps[2], 0, 0, 0);
 
-    // Add main dial
-    al_draw_bitmap(bitmaps[2], 0, 0, 0);
+        if (globals.enableShadows) {
+            // Multiply (shades of grey darken, white has no effect)
+            beginShadows();
 
-    if (globals.enableShadows) {
-        // Set blender to multiply (shades of grey darken, white has no effect)
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_DEST_COLOR, ALLEGRO_ZERO);
+            // Add pointer shadow
+            drawScaledRotatedBitmap(bitmaps[4], 400,50, 415 * scaleFactor, 415 * scaleFactor, scaleFactor, scaleFactor, angle * AngleFactor, 0);
 
-        // Add pointer shadow
-        al_draw_scaled_rotated_bitmap(bitmaps[4], 400,50, 415 * scaleFactor, 415 * scaleFactor, scaleFactor, scaleFactor, angle * AngleFactor, 0);
+            // Back to normal drawing
+            endShadows();
+        }
 
-        // Restore normal blender
-        al_set_blender(ALLEGRO_ADD, ALLEGRO_ALPHA, ALLEGRO_INVERSE_ALPHA);
+        // Add pointer
+        drawScaledRotatedBitmap(bitmaps[3], 400, 50, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle * AngleFactor, 0);
     }
 
-    // Add pointer
-    al_draw_scaled_rotated_bitmap(bitmaps[3], 400, 50, 400 * scaleFactor, 400 * scaleFactor, scaleFactor, scaleFactor, angle * AngleFactor, 0);
-
-    // Position dest bitmap on screen
-    al_set_target_backbuffer(globals.display);
-    al_draw_bitmap(bitmaps[1], xPos, yPos, 0);
-
-    if (!globals.active) {
-        dimInstrument();
-    }
+    // Position dest bitmap on screen (dimmed when not connected)
+    endRender(!globals.active);
 }
 
 /// <summary>
@@ -107,13 +107,21 @@ void vsi::update()
     xPos = settings[0];
     yPos = settings[1];
 
-    if (size != settings[2]) {
+    if (sizeChanged(settings[2])) {
         size = settings[2];
         resize();
     }
+}
 
+/// <summary>
+/// Move needles one fixed step towards the latest FlightSim values
+/// </summary>
+void vsi::step()
+{
     // Get latest FlightSim variables
-    SimVars* simVars = &globals.simVars->simVars;
+    SimVars* simVars = globals.simVars->simVars;
+
+    prevAngle = stepAngle;
 
     // Calculate values
     if (simVars->vsiVerticalSpeed < 0) {
@@ -130,25 +138,25 @@ void vsi::update()
         targetAngle = -123;
     }
 
-    double diff = abs(targetAngle - angle);
+    double diff = abs(targetAngle - stepAngle);
 
     if (diff > 40.0) {
-        if (angle < targetAngle) angle += 20.0; else angle -= 20.0;
+        if (stepAngle < targetAngle) stepAngle += 20.0; else stepAngle -= 20.0;
     }
     else if (diff > 20.0) {
-        if (angle < targetAngle) angle += 10.0; else angle -= 10.0;
+        if (stepAngle < targetAngle) stepAngle += 10.0; else stepAngle -= 10.0;
     }
     else if (diff > 10.0) {
-        if (angle < targetAngle) angle += 5.0; else angle -= 5.0;
+        if (stepAngle < targetAngle) stepAngle += 5.0; else stepAngle -= 5.0;
     }
     else if (diff > 5.0) {
-        if (angle < targetAngle) angle += 2.5; else angle -= 2.5;
+        if (stepAngle < targetAngle) stepAngle += 2.5; else stepAngle -= 2.5;
     }
     else if (diff > 1.25) {
-        if (angle < targetAngle) angle += 1.25; else angle -= 1.25;
+        if (stepAngle < targetAngle) stepAngle += 1.25; else stepAngle -= 1.25;
     }
     else {
-        angle = targetAngle;
+        stepAngle = targetAngle;
     }
 }
 
@@ -10,12 +10,15 @@ private:
 
     // Instrument values (caclulated from variables and needed to draw the instrument)
     double angle = 0;
+    double stepAngle = 0;
+    double prevAngle = 0;
     double targetAngle;
 
 public:
     vsi(int xPos, int yPos, int size);
     void render();
     void update();
+    void step();
 
 private:
     void resize();
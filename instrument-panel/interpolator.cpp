@@ -0,0 +1,139 @@
+#include <math.h>
+#include "interpolator.h"
+
+/// <summary>
+/// Adds a var (as an offset in doubles into SimVars) to be smoothed.
+/// Angles that wrap around, e.g. heading 0 to 360, must supply the range
+/// so they are interpolated the short way round.
+/// </summary>
+void interpolator::addVar(int offset, double wrapMin, double wrapRange)
+{
+    if (varCount == MaxVars) {
+        return;
+    }
+
+    vars[varCount].offset = offset;
+    vars[varCount].wrapMin = wrapMin;
+    vars[varCount].wrapRange = wrapRange;
+    varCount++;
+}
+
+/// <summary>
+/// Adds a newly received sample to the history.
+/// </summary>
+void interpolator::addSample(const SimVars* simVars, const SampleTimes* times)
+{
+    if (times->receiveTime == 0) {
+        // Not a real sample (data link lost) so start again
+        count = 0;
+        return;
+    }
+
+    // Time the sample would have arrived with no network jitter
+    int64_t time = times->receiveTime;
+    if (times->networkUs >= 0) {
+        if (windowMinUs == -1 || times->networkUs < windowMinUs) {
+            windowMinUs = times->networkUs;
+        }
+        if (minNetworkUs == -1 || windowMinUs < minNetworkUs) {
+            minNetworkUs = windowMinUs;
+        }
+        if (++windowSamples == MinNetworkWindow) {
+            // Let the minimum follow any drift between the two clocks
+            minNetworkUs = windowMinUs;
+            windowMinUs = -1;
+            windowSamples = 0;
+        }
+
+        time -= times->networkUs - minNetworkUs;
+    }
+
+    if (count > 0 && time <= sampleTime[newest]) {
+        // Out of order or no time has passed
+        time = sampleTime[newest] + 1;
+    }
+
+    newest = (newest + 1) % HistorySize;
+    sampleTime[newest] = time;
+    for (int i = 0; i < varCount; i++) {
+        history[newest][i] = *((double*)simVars + vars[i].offset);
+    }
+
+    if (count < HistorySize) {
+        count++;
+    }
+}
+
+double interpolator::estimateVar(int var, int from, int to, int64_t time, bool extrapolate)
+{
+    double fromVal = history[from][var];
+    double diff = history[to][var] - fromVal;
+    double range = vars[var].wrapRange;
+
+    if (range != 0) {
+        // Go the short way round
+        if (diff > range / 2) {
+            diff -= range;
+        }
+        else if (diff < -range / 2) {
+            diff += range;
+        }
+    }
+
+    double fraction = (double)(time - sampleTime[from]) / (sampleTime[to] - sampleTime[from]);
+    if (!extrapolate && fraction > 1) {
+        fraction = 1;
+    }
+
+    double val = fromVal + diff * fraction;
+
+    if (range != 0) {
+        val -= range * floor((val - vars[var].wrapMin) / range);
+    }
+
+    return val;
+}
+
+/// <summary>
+/// Writes the estimated value of each var at renderTime (less the
+/// configured delay) into simVars.
+/// </summary>
+void interpolator::estimate(SimVars* simVars, int64_t renderTime)
+{
+    if (count < 2) {
+        return;
+    }
+
+    int64_t time = renderTime - delayUs;
+    int prev = (newest + HistorySize - 1) % HistorySize;
+    int from = prev;
+    int to = newest;
+    bool extrapolate = false;
+
+    if (time >= sampleTime[newest]) {
+        // Beyond the newest sample so extrapolate, but not too far
+        if (time > sampleTime[newest] + horizonUs) {
+            time = sampleTime[newest] + horizonUs;
+        }
+        extrapolate = true;
+    }
+    else {
+        // Find the samples either side
+        for (int i = 1; i < count; i++) {
+            to = (newest + HistorySize - i + 1) % HistorySize;
+            from = (newest + HistorySize - i) % HistorySize;
+            if (time >= sampleTime[from]) {
+                break;
+            }
+        }
+
+        if (time < sampleTime[from]) {
+            // Older than all history
+            time = sampleTime[from];
+        }
+    }
+
+    for (int i = 0; i < varCount; i++) {
+        *((double*)simVars + vars[i].offset) = estimateVar(i, from, to, time, extrapolate);
+    }
+}
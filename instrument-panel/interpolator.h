@@ -0,0 +1,52 @@
+#ifndef _INTERPOLATOR_H_
+#define _INTERPOLATOR_H_
+
+#include "simvarDefs.h"
+#include "latency.h"
+
+/// <summary>
+/// Keeps the last few samples of fast moving SimVars (pitch, bank,
+/// heading, airspeed etc.) and estimates their value at the time a frame
+/// will be shown. Between samples the value is interpolated and beyond
+/// the newest sample it is extrapolated for up to horizon microseconds,
+/// so needles move smoothly even if packets are late or lost.
+/// </summary>
+class interpolator {
+private:
+    static const int HistorySize = 4;
+    static const int MaxVars = 16;
+    static const int MinNetworkWindow = 256;
+
+    struct Var {
+        int offset;
+        double wrapMin;
+        double wrapRange;
+    };
+
+    Var vars[MaxVars];
+    int varCount = 0;
+
+    double history[HistorySize][MaxVars];
+    int64_t sampleTime[HistorySize];
+    int newest = 0;
+    int count = 0;
+
+    // Network jitter is removed from sample times using the smallest
+    // network latency seen recently.
+    int64_t minNetworkUs = -1;
+    int64_t windowMinUs = -1;
+    int windowSamples = 0;
+
+    double estimateVar(int var, int from, int to, int64_t time, bool extrapolate);
+
+public:
+    int64_t delayUs = 0;
+    int64_t horizonUs = 0;
+
+    void addVar(int offset, double wrapMin = 0, double wrapRange = 0);
+    void addSample(const SimVars* simVars, const SampleTimes* times);
+    void estimate(SimVars* simVars, int64_t renderTime);
+    void reset() { count = 0; }
+};
+
+#endif // _INTERPOLATOR_H_
@@ -1,6 +1,7 @@
 #ifndef _WIN32
 #include <wiringPi.h>
 #include "knobs.h"
+#include "scheduler.h"
 
 void watcher(knobs*);
 
@@ -139,6 +140,11 @@ void watcher(knobs *t)
                 }
 
                 t->lastState[num] = state;
+
+                // Show the change at the full frame rate
+                if (globals.frameScheduler) {
+                    globals.frameScheduler->wake();
+                }
             }
         }
 
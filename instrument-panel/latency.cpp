@@ -0,0 +1,164 @@
+#include <stdio.h>
+#include <chrono>
+#include "latency.h"
+
+/// <summary>
+/// Microseconds on a monotonic clock. Only used for intervals on this host.
+/// </summary>
+int64_t latency::now()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int latencyHistogram::bucketIndex(int64_t us)
+{
+    if (us < 2 * SubBuckets) {
+        return us < 0 ? 0 : (int)us;
+    }
+
+    int msb = 63;
+    while ((us & ((int64_t)1 << msb)) == 0) {
+        msb--;
+    }
+
+    int shift = msb - 4;
+    int idx = shift * SubBuckets + (int)(us >> shift);
+    return idx < BucketCount ? idx : BucketCount - 1;
+}
+
+/// <summary>
+/// Returns the highest value that falls in a bucket.
+/// </summary>
+int64_t latencyHistogram::bucketValue(int idx)
+{
+    if (idx < 2 * SubBuckets) {
+        return idx;
+    }
+
+    int shift = idx / SubBuckets - 1;
+    int64_t sub = idx - shift * SubBuckets;
+    return (sub << shift) + ((int64_t)1 << shift) - 1;
+}
+
+void latencyHistogram::record(int64_t us)
+{
+    counts[bucketIndex(us)]++;
+    total++;
+    if (us > max) {
+        max = us;
+    }
+}
+
+int64_t latencyHistogram::percentile(double percent)
+{
+    if (total == 0) {
+        return 0;
+    }
+
+    uint64_t target = (uint64_t)(total * percent / 100.0 + 0.5);
+    if (target < 1) {
+        target = 1;
+    }
+
+    uint64_t count = 0;
+    for (int i = 0; i < BucketCount; i++) {
+        count += counts[i];
+        if (count >= target) {
+            int64_t value = bucketValue(i);
+            return value < max ? value : max;
+        }
+    }
+
+    return max;
+}
+
+void latencyHistogram::dump(FILE* outfile)
+{
+    fprintf(outfile, "%-10s %9llu %9lld %9lld %9lld %9lld %9lld\n", name, (unsigned long long)total,
+        (long long)percentile(50), (long long)percentile(90), (long long)percentile(99),
+        (long long)percentile(99.9), (long long)max);
+}
+
+/// <summary>
+/// Called at the start of doUpdate for every frame.
+/// </summary>
+void latency::frameStarted()
+{
+    startedTime = now();
+}
+
+/// <summary>
+/// Called by doUpdate when it picks up a new sample.
+/// </summary>
+void latency::sampleConsumed(const SampleTimes* times)
+{
+    if (times->receiveTime == 0) {
+        // Not a real sample (data link lost)
+        return;
+    }
+
+    if (havePending) {
+        // Previous sample was replaced before it was ever drawn
+        samplesSkipped++;
+    }
+
+    if (lastSequence != 0 && times->sequence - lastSequence > 1) {
+        // Overwritten in the triple buffer before doUpdate saw them
+        samplesSkipped += times->sequence - lastSequence - 1;
+    }
+    lastSequence = times->sequence;
+
+    pending = *times;
+    havePending = true;
+    consumedTime = now();
+}
+
+/// <summary>
+/// Called when doRender has finished drawing, just before the flip.
+/// </summary>
+void latency::frameRendered()
+{
+    renderedTime = now();
+}
+
+/// <summary>
+/// Called after al_flip_display. Only frames showing a new sample are
+/// counted so idle frames don't hide the age of the data.
+/// </summary>
+void latency::frameFlipped()
+{
+    int64_t flippedTime = now();
+    frames++;
+
+    // Running average of how long after doUpdate a frame appears
+    leadUs += (flippedTime - startedTime - leadUs) / 8;
+
+    if (!havePending) {
+        return;
+    }
+
+    if (pending.networkUs >= 0) {
+        network.record(pending.networkUs);
+    }
+    queueing.record(consumedTime - pending.receiveTime);
+    render.record(renderedTime - consumedTime);
+    present.record(flippedTime - renderedTime);
+    endToEnd.record((pending.networkUs >= 0 ? pending.networkUs : 0) + flippedTime - pending.receiveTime);
+
+    samplesDisplayed++;
+    havePending = false;
+}
+
+void latency::dump(FILE* outfile)
+{
+    fprintf(outfile, "Latency (us)\n");
+    fprintf(outfile, "%-10s %9s %9s %9s %9s %9s %9s\n", "", "count", "p50", "p90", "p99", "p99.9", "max");
+    network.dump(outfile);
+    queueing.dump(outfile);
+    render.dump(outfile);
+    present.dump(outfile);
+    endToEnd.dump(outfile);
+    fprintf(outfile, "Frames: %llu  Samples displayed: %llu  Skipped: %llu\n", (unsigned long long)frames,
+        (unsigned long long)samplesDisplayed, (unsigned long long)samplesSkipped);
+}
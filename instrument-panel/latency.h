@@ -0,0 +1,76 @@
+#ifndef _LATENCY_H_
+#define _LATENCY_H_
+
+#include <stdio.h>
+#include <stdint.h>
+
+// Timestamps that travel with each sample through the triple buffer
+struct SampleTimes {
+    uint32_t sequence = 0;
+    int64_t networkUs = -1;
+    int64_t receiveTime = 0;
+};
+
+/// <summary>
+/// HDR style histogram of latencies in microseconds. Values are counted
+/// exactly up to 32us and then in 16 buckets per power of 2, i.e. to
+/// within about 6%, so a huge range can be held in a small fixed table.
+/// </summary>
+class latencyHistogram {
+private:
+    static const int SubBuckets = 16;
+    static const int BucketCount = 40 * SubBuckets;
+    uint64_t counts[BucketCount] = {};
+    uint64_t total = 0;
+    int64_t max = 0;
+
+    int bucketIndex(int64_t us);
+    int64_t bucketValue(int idx);
+
+public:
+    const char* name;
+
+    latencyHistogram(const char* name) { this->name = name; }
+    void record(int64_t us);
+    int64_t percentile(double percent);
+    void dump(FILE* outfile);
+};
+
+/// <summary>
+/// Measures how old the data on screen is. Each sample is timed from the
+/// data link sending it to the frame showing it being flipped, split into
+/// network, queueing (received to picked up by doUpdate), render and
+/// present (al_flip_display) stages.
+/// </summary>
+class latency {
+private:
+    latencyHistogram network{ "network" };
+    latencyHistogram queueing{ "queueing" };
+    latencyHistogram render{ "render" };
+    latencyHistogram present{ "present" };
+    latencyHistogram endToEnd{ "total" };
+
+    SampleTimes pending;
+    bool havePending = false;
+    int64_t startedTime = 0;
+    int64_t consumedTime = 0;
+    int64_t renderedTime = 0;
+    int64_t leadUs = 0;
+    uint32_t lastSequence = 0;
+
+    uint64_t samplesDisplayed = 0;
+    uint64_t samplesSkipped = 0;
+    uint64_t frames = 0;
+
+public:
+    static int64_t now();
+
+    void frameStarted();
+    int64_t presentLead() { return leadUs; }
+    void sampleConsumed(const SampleTimes* times);
+    void frameRendered();
+    void frameFlipped();
+    void dump(FILE* outfile);
+};
+
+#endif // _LATENCY_H_
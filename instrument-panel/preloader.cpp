@@ -0,0 +1,148 @@
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+#include "preloader.h"
+#include "globals.h"
+#include "simvars.h"
+#include "latency.h"
+#include "bitmapPack.h"
+
+extern globalVars globals;
+
+// Sheets loaded by each instrument when it is created
+const preloader::Asset preloader::Assets[] = {
+    { "ADI Learjet", "adi-learjet.png" },
+    { "ASI", "asi.png" },
+    { "ASI", "asi-fast.png" },
+    { "ASI", "asi-savage-cub.png" },
+    { "ADI", "adi.png" },
+    { "ALT", "alt.png" },
+    { "ALT", "alt-fast.png" },
+    { "VOR1", "vor1.png" },
+    { "TC", "tc.png" },
+    { "HI", "hi.png" },
+    { "VSI", "vsi.png" },
+    { "VOR2", "vor2.png" },
+    { "Trim Flaps", "trim-flaps.png" },
+    { "RPM", "rpm.png" },
+    { "ADF", "adf.png" },
+    { "Annunciator", "annunciator.png" },
+    { "Digital Clock", "digital-clock.png" },
+    { "Fuel", "fuel.png" },
+    { "EGT", "egt.png" },
+    { "VAC", "vac.png" },
+    { "Oil", "oil.png" },
+    { "Nav", "nav.png" },
+    { NULL, NULL }
+};
+
+/// <summary>
+/// Decodes the sheets of all enabled instruments and waits for them.
+/// Sheets that fail to decode are left for the instrument to load (and
+/// report) itself.
+/// </summary>
+preloader::preloader()
+{
+    for (int i = 0; Assets[i].instrument; i++) {
+        // No need to decode anything the pack already has
+        if (globals.assetPack && globals.assetPack->has(Assets[i].filename)) {
+            continue;
+        }
+
+        if (globals.simVars->isEnabled(Assets[i].instrument)) {
+            decoded[decodedCount].filename = Assets[i].filename;
+            decoded[decodedCount].bitmap = NULL;
+            decoded[decodedCount].decodeUs = 0;
+            decodedCount++;
+        }
+    }
+
+    int threadCount = std::thread::hardware_concurrency();
+    if (threadCount < 1) {
+        threadCount = 1;
+    }
+    else if (threadCount > MaxThreads) {
+        threadCount = MaxThreads;
+    }
+    if (threadCount > decodedCount) {
+        threadCount = decodedCount;
+    }
+
+    int64_t startTime = latency::now();
+
+    std::thread* threads[MaxThreads];
+    for (int i = 0; i < threadCount; i++) {
+        threads[i] = new std::thread(worker, this);
+    }
+
+    for (int i = 0; i < threadCount; i++) {
+        threads[i]->join();
+        delete threads[i];
+    }
+
+    printf("Preload: Decoded %d bitmaps in %lld ms on %d threads\n", decodedCount,
+        (long long)(latency::now() - startTime) / 1000, threadCount);
+}
+
+/// <summary>
+/// Frees any decoded bitmaps that no instrument took.
+/// </summary>
+preloader::~preloader()
+{
+    for (int i = 0; i < decodedCount; i++) {
+        if (decoded[i].bitmap) {
+            al_destroy_bitmap(decoded[i].bitmap);
+        }
+    }
+}
+
+/// <summary>
+/// Worker thread. Keeps taking the next sheet to decode until there are
+/// none left.
+/// </summary>
+void preloader::worker(preloader* loader)
+{
+    // New bitmap flags are per thread
+    al_set_new_bitmap_flags(ALLEGRO_MEMORY_BITMAP);
+
+    int i;
+    while ((i = loader->nextDecode++) < loader->decodedCount) {
+        Decoded* asset = &loader->decoded[i];
+
+        char filepath[256];
+        strcpy(filepath, globals.BitmapDir);
+        strcat(filepath, asset->filename);
+
+        int64_t startTime = latency::now();
+        asset->bitmap = al_load_bitmap(filepath);
+        asset->decodeUs = latency::now() - startTime;
+    }
+}
+
+/// <summary>
+/// Returns the decoded sheet as a video bitmap or NULL if it wasn't
+/// preloaded. Must be called on the display thread. Each sheet can only
+/// be taken once and the caller owns it.
+/// </summary>
+ALLEGRO_BITMAP* preloader::take(const char* filename)
+{
+    for (int i = 0; i < decodedCount; i++) {
+        Decoded* asset = &decoded[i];
+        if (asset->bitmap == NULL || strcmp(asset->filename, filename) != 0) {
+            continue;
+        }
+
+        ALLEGRO_BITMAP* bitmap = asset->bitmap;
+        asset->bitmap = NULL;
+
+        int64_t startTime = latency::now();
+        al_convert_bitmap(bitmap);
+
+        printf("Preload: %s decoded in %lld ms, uploaded in %lld ms\n", filename,
+            (long long)asset->decodeUs / 1000, (long long)(latency::now() - startTime) / 1000);
+
+        return bitmap;
+    }
+
+    return NULL;
+}
@@ -0,0 +1,45 @@
+#ifndef _PRELOADER_H_
+#define _PRELOADER_H_
+
+#include <atomic>
+#include <stdint.h>
+#include <allegro5/allegro.h>
+
+/// <summary>
+/// Decodes the PNGs of every enabled instrument at startup on a pool of
+/// worker threads so the large sheets aren't loaded one after another.
+/// Workers decode into memory bitmaps and the display thread uploads
+/// each one to a video bitmap when an instrument loads it (see take).
+/// </summary>
+class preloader
+{
+private:
+    static const int MaxThreads = 4;
+    static const int MaxAssets = 32;
+
+    struct Asset {
+        const char* instrument;
+        const char* filename;
+    };
+
+    struct Decoded {
+        const char* filename;
+        ALLEGRO_BITMAP* bitmap;
+        int64_t decodeUs;
+    };
+
+    static const Asset Assets[];
+
+    Decoded decoded[MaxAssets];
+    int decodedCount = 0;
+    std::atomic<int> nextDecode{ 0 };
+
+    static void worker(preloader* loader);
+
+public:
+    preloader();
+    ~preloader();
+    ALLEGRO_BITMAP* take(const char* filename);
+};
+
+#endif // _PRELOADER_H_
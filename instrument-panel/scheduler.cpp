@@ -0,0 +1,99 @@
+#include <stdio.h>
+#include "scheduler.h"
+#include "globals.h"
+#include "latency.h"
+
+extern globalVars globals;
+
+void fatalError(const char* msg);
+
+scheduler::scheduler(ALLEGRO_EVENT_QUEUE* eventQueue)
+{
+    if (globals.frameRate <= 0) {
+        globals.frameRate = 30;
+    }
+
+    if (globals.idleFrameRate <= 0 || globals.idleFrameRate > globals.frameRate) {
+        globals.idleFrameRate = globals.frameRate;
+    }
+
+    if (!(timer = al_create_timer(1.0 / globals.frameRate))) {
+        fatalError("Failed to create timer");
+    }
+
+    al_init_user_event_source(&wakeSource);
+    al_register_event_source(eventQueue, al_get_timer_event_source(timer));
+    al_register_event_source(eventQueue, &wakeSource);
+
+    wakeTime = latency::now();
+
+    // First frame takes a single step
+    stepTime = wakeTime - StepUs;
+}
+
+scheduler::~scheduler()
+{
+    al_destroy_timer(timer);
+    al_destroy_user_event_source(&wakeSource);
+}
+
+void scheduler::start()
+{
+    al_start_timer(timer);
+}
+
+/// <summary>
+/// Goes back to the full frame rate straight away. Safe to call from
+/// any thread and cheap if already at the full rate.
+/// </summary>
+void scheduler::wake()
+{
+    wakeTime = latency::now();
+
+    if (idle.exchange(false)) {
+        ALLEGRO_EVENT event;
+        event.user.type = WakeEvent;
+        al_emit_user_event(&wakeSource, &event, NULL);
+    }
+}
+
+/// <summary>
+/// Call from the main thread for every event to pick the frame rate.
+/// </summary>
+void scheduler::update()
+{
+    bool wantIdle = !globals.arranging && !globals.simulating
+        && (!globals.dataLinked || !globals.active)
+        && latency::now() - wakeTime > WakeHoldUs;
+
+    double rate = wantIdle ? globals.idleFrameRate : globals.frameRate;
+    if (al_get_timer_speed(timer) != 1.0 / rate) {
+        al_set_timer_speed(timer, 1.0 / rate);
+        printf("Frame rate: %g fps%s\n", rate, wantIdle ? " (idle)" : "");
+    }
+
+    idle = wantIdle;
+}
+
+/// <summary>
+/// Works out how many fixed steps instruments must take to catch up
+/// with now and how far now is past the last one. Call once before
+/// each frame is updated.
+/// </summary>
+void scheduler::advance()
+{
+    int64_t now = latency::now();
+    int64_t steps = (now - stepTime) / StepUs;
+
+    if (steps > MaxSteps) {
+        // Drop the backlog but keep the step phase
+        stepTime = now - (now - stepTime) % StepUs;
+        steps = MaxSteps;
+    }
+    else {
+        stepTime += steps * StepUs;
+    }
+
+    globals.frameSteps = (int)steps;
+    globals.stepFraction = (double)(now - stepTime) / StepUs;
+}
@@ -0,0 +1,49 @@
+#ifndef _SCHEDULER_H_
+#define _SCHEDULER_H_
+
+#include <atomic>
+#include <stdint.h>
+#include <allegro5/allegro.h>
+
+/// <summary>
+/// Decides how often frames are drawn. Runs at the Frame Rate while the
+/// sim is active and drops to the Idle Frame Rate when the screensaver
+/// is on or the data link is down, so idle panels don't run hot. Any
+/// thread can call wake (new data, a knob being turned) to go straight
+/// back to the full rate.
+///
+/// Instruments step their needles at a fixed rate whatever the frame
+/// rate is, catching up after a slow frame, and draw them part way
+/// between the last two steps. Needles move the same at any frame rate.
+/// </summary>
+class scheduler
+{
+private:
+    // Stay at the full rate for this long after being woken
+    static const int64_t WakeHoldUs = 5000000;
+
+    // Needle step sizes were tuned for 30 steps a second
+    static const int64_t StepUs = 1000000 / 30;
+
+    // Give up catching up after a long stall (e.g. moving the window)
+    static const int MaxSteps = 30;
+
+    ALLEGRO_TIMER* timer = NULL;
+    ALLEGRO_EVENT_SOURCE wakeSource;
+    std::atomic<bool> idle{ false };
+    std::atomic<int64_t> wakeTime{ 0 };
+    int64_t stepTime = 0;
+
+public:
+    static const int WakeEvent = ALLEGRO_GET_EVENT_TYPE('W', 'A', 'K', 'E');
+
+    scheduler(ALLEGRO_EVENT_QUEUE* eventQueue);
+    ~scheduler();
+    void start();
+    void wake();
+    void update();
+    void advance();
+    bool isIdle() { return idle; }
+};
+
+#endif // _SCHEDULER_H_
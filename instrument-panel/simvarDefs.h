@@ -2,6 +2,7 @@
 #define _SIMVARDEFS_H_
 
 #include <stdio.h>
+#include <stdint.h>
 
 struct SimVars
 {
@@ -131,4 +132,60 @@ struct WriteData {
     double value;
 };
 
+// Sent instead of a poll to ask the data link to stream SimVars at the
+// requested rate (samples per second). The data link stops streaming if
+// the subscription is not renewed within leaseMs. A rate of 0 cancels the
+// subscription. Data link builds that don't support this either ignore it
+// or reply with their data size so the panel can fall back to polling.
+//
+// Streamed data uses the delta format below with a keyframe every
+// keyframeInterval packets. Setting SubscribeKeyframe in flags asks for
+// a keyframe straight away, e.g. when the panel has missed a packet.
+//
+// Only the fields with their bit set in fields (numbered as for the delta
+// format) are sent so a panel only pays for the instruments it shows.
+//
+// If multicastAddr (network byte order) is set the data link publishes to
+// that group and port instead of the panel's own address. All panels that
+// subscribe to the same group share one stream which carries the union of
+// their fields at the highest rate any of them asked for.
+const long SubscribeMagic = 0x53554253;
+const int SubscribeKeyframe = 1;
+const int MaxSimVarFields = 128;
+
+struct SubscribeRequest {
+    long magic = SubscribeMagic;
+    long dataSize = sizeof(SimVars);
+    int rate = 0;
+    int leaseMs = 0;
+    int keyframeInterval = 0;
+    int flags = 0;
+    uint32_t fields[MaxSimVarFields / 32] = {};
+    uint32_t multicastAddr = 0;
+    int multicastPort = 0;
+};
+
+// Delta format. Each datagram is a DeltaHeader followed by the new value
+// of every field that has its bit set in changed, in SimVars order. Field
+// 0 is connected and the rest follow SimVarDefs. Doubles are sent as 8
+// bytes and strings as a length byte followed by the characters (no
+// terminator). A keyframe contains every field. Both ends are assumed to
+// be little endian.
+//
+// sendTime is the sender's clock in microseconds since the epoch so the
+// panel can measure network latency (hosts need synchronised clocks).
+const uint32_t DeltaMagic = 0x544c4544;
+const uint32_t DeltaIsKeyframe = 1;
+
+struct DeltaHeader {
+    uint32_t magic;
+    uint32_t sequence;
+    int64_t sendTime;
+    uint32_t flags;
+    uint32_t changed[MaxSimVarFields / 32];
+};
+
+// Largest possible delta datagram (keyframe with every string full length)
+const int MaxDeltaSize = sizeof(DeltaHeader) + sizeof(SimVars) + MaxSimVarFields;
+
 #endif // _SIMVARDEFS_H_
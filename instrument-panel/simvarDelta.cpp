@@ -0,0 +1,164 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <chrono>
+#include "simvarDelta.h"
+
+extern const char* SimVarDefs[][2];
+
+SimVarField SimVarFields[MaxSimVarFields];
+int SimVarFieldCount = 0;
+
+/// <summary>
+/// Builds the field table used to encode and decode deltas. Field 0 is
+/// connected, the rest are taken from SimVarDefs where the units give the
+/// size of string fields. Returns false if the table doesn't match the
+/// SimVars struct.
+/// </summary>
+bool initSimVarFields()
+{
+    int offset = 0;
+
+    SimVarFields[0].name = "Connected";
+    SimVarFields[0].offset = offset;
+    SimVarFields[0].size = sizeof(double);
+    SimVarFields[0].isString = false;
+    offset += sizeof(double);
+    SimVarFieldCount = 1;
+
+    for (int i = 0; SimVarDefs[i][0] != NULL; i++) {
+        if (SimVarFieldCount == MaxSimVarFields) {
+            return false;
+        }
+
+        SimVarField* field = &SimVarFields[SimVarFieldCount];
+        field->name = SimVarDefs[i][0];
+        field->offset = offset;
+
+        if (strncmp(SimVarDefs[i][1], "string", 6) == 0) {
+            field->size = atoi(SimVarDefs[i][1] + 6);
+            field->isString = true;
+        }
+        else {
+            field->size = sizeof(double);
+            field->isString = false;
+        }
+
+        offset += field->size;
+        SimVarFieldCount++;
+    }
+
+    return offset == sizeof(SimVars);
+}
+
+/// <summary>
+/// Microseconds since the epoch, used to stamp deltas when they are sent.
+/// </summary>
+int64_t deltaTimestamp()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+/// <summary>
+/// Writes a delta containing every field that differs between prev and
+/// latest (or every field if keyframe is true). If fields is supplied only
+/// fields with their bit set are considered. Packet must be at least
+/// MaxDeltaSize bytes. Returns the number of bytes to send.
+/// </summary>
+int encodeDelta(char* packet, const SimVars* prev, const SimVars* latest, uint32_t sequence, bool keyframe, const uint32_t* fields)
+{
+    DeltaHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = DeltaMagic;
+    header.sequence = sequence;
+    header.sendTime = deltaTimestamp();
+    header.flags = keyframe ? DeltaIsKeyframe : 0;
+
+    char* pos = packet + sizeof(DeltaHeader);
+
+    for (int i = 0; i < SimVarFieldCount; i++) {
+        if (fields && (fields[i / 32] & (1u << (i % 32))) == 0) {
+            continue;
+        }
+
+        SimVarField* field = &SimVarFields[i];
+        const char* newVal = (const char*)latest + field->offset;
+        const char* oldVal = (const char*)prev + field->offset;
+
+        if (field->isString) {
+            if (!keyframe && strncmp(newVal, oldVal, field->size) == 0) {
+                continue;
+            }
+
+            int len = (int)strnlen(newVal, field->size - 1);
+            *pos++ = (char)len;
+            memcpy(pos, newVal, len);
+            pos += len;
+        }
+        else {
+            if (!keyframe && memcmp(newVal, oldVal, field->size) == 0) {
+                continue;
+            }
+
+            memcpy(pos, newVal, field->size);
+            pos += field->size;
+        }
+
+        header.changed[i / 32] |= 1u << (i % 32);
+    }
+
+    memcpy(packet, &header, sizeof(header));
+    return (int)(pos - packet);
+}
+
+/// <summary>
+/// Applies a received delta to simVars. Returns false (and leaves
+/// simVars partially updated) if the packet is malformed.
+/// </summary>
+bool applyDelta(SimVars* simVars, const char* packet, int bytes)
+{
+    if (bytes < (int)sizeof(DeltaHeader)) {
+        return false;
+    }
+
+    DeltaHeader header;
+    memcpy(&header, packet, sizeof(header));
+
+    const char* pos = packet + sizeof(DeltaHeader);
+    const char* end = packet + bytes;
+
+    for (int i = 0; i < SimVarFieldCount; i++) {
+        if ((header.changed[i / 32] & (1u << (i % 32))) == 0) {
+            continue;
+        }
+
+        SimVarField* field = &SimVarFields[i];
+        char* val = (char*)simVars + field->offset;
+
+        if (field->isString) {
+            if (pos >= end) {
+                return false;
+            }
+
+            int len = (unsigned char)*pos++;
+            if (len >= field->size || pos + len > end) {
+                return false;
+            }
+
+            memcpy(val, pos, len);
+            val[len] = '\0';
+            pos += len;
+        }
+        else {
+            if (pos + field->size > end) {
+                return false;
+            }
+
+            memcpy(val, pos, field->size);
+            pos += field->size;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,21 @@
+#ifndef _SIMVARDELTA_H_
+#define _SIMVARDELTA_H_
+
+#include "simvarDefs.h"
+
+struct SimVarField {
+    const char* name;
+    int offset;
+    int size;
+    bool isString;
+};
+
+extern SimVarField SimVarFields[MaxSimVarFields];
+extern int SimVarFieldCount;
+
+bool initSimVarFields();
+int64_t deltaTimestamp();
+int encodeDelta(char* packet, const SimVars* prev, const SimVars* latest, uint32_t sequence, bool keyframe, const uint32_t* fields = NULL);
+bool applyDelta(SimVars* simVars, const char* packet, int bytes);
+
+#endif // _SIMVARDELTA_H_
@@ -1,17 +1,55 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <chrono>
 #include <allegro5/allegro.h>
 #ifdef _WIN32
 #include <WS2tcpip.h>
+#else
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <sys/timerfd.h>
 #endif
 #include "simvars.h"
+#include "simvarDelta.h"
+#include "flightRecorder.h"
+#include "scheduler.h"
 
 const char *DataLinkGroup = "Data Link";
 const char *DataLinkHost = "Host";
 const char *DataLinkPort = "Port";
+const char *DataLinkRate = "Rate";
+const char *DataLinkMulticast = "Multicast Group";
+const char *DataLinkMulticastPort = "Multicast Port";
+const char *DataLinkSmoothing = "Smoothing";
+const char *DataLinkSmoothingDelay = "Smoothing Delay";
+const char *DataLinkSmoothingHorizon = "Smoothing Horizon";
+const char *DataLinkRecord = "Record";
 const char *MonitorGroup = "Monitor";
 const char *MonitorStartOn = "StartOn";
+const char *RenderGroup = "Render";
+const char *RenderDirect = "Direct";
+const char *RenderShaders = "Shaders";
+const char *RenderFrameRate = "Frame Rate";
+const char *RenderIdleFrameRate = "Idle Frame Rate";
+
+// Subscriptions must be renewed within the lease time. If the data link
+// hasn't streamed anything after this many renewals we try polling.
+const int SubscribeLeaseMs = 3000;
+const int SubscribeRetries = 3;
+
+// Data link sends a full keyframe this often (in packets) between deltas
+const int KeyframeInterval = 50;
+
+// In poll mode the next request is sent this long after each reply
+const int PollIntervalMs = 10;
+const int PollTimeoutMs = 500;
+
+// Datagrams read per recvmmsg call when draining the socket
+const int DrainBatch = 16;
+
+// Screensaver activates when rpm hasn't changed for this long
+const int ScreensaverIdleMs = 30000;
 
 extern const char* SimVarDefs[][2];
 
@@ -21,9 +59,39 @@ void fatalError(const char* msg);
 
 simvars::simvars()
 {
+    simVars = &buffers[readIdx];
     loadSettings();
 
-    // Start data link thread
+    if (!initSimVarFields()) {
+        fatalError("SimVarDefs do not match SimVars struct");
+    }
+
+    // Data link thread always needs these (field 0 is connected)
+    fields[0] |= 1;
+    useVar("Common", "General Eng Rpm:1");
+    useVar("Common", "Estimated Cruise Speed");
+    useVar("Common", "Title");
+
+    // Fast moving vars that are smoothed between samples
+    smoother.delayUs = globals.smoothingDelayMs * 1000;
+    smoother.horizonUs = globals.smoothingHorizonMs * 1000;
+    addSmoothVar("Indicated Altitude");
+    addSmoothVar("Attitude Indicator Pitch Degrees");
+    addSmoothVar("Attitude Indicator Bank Degrees", -180, 360);
+    addSmoothVar("Airspeed Indicated");
+    addSmoothVar("Plane Heading Degrees Magnetic", 0, 360);
+    addSmoothVar("Vertical Speed");
+    addSmoothVar("Turn Indicator Rate");
+    addSmoothVar("Turn Coordinator Ball");
+    addSmoothVar("General Eng Rpm:1");
+}
+
+/// <summary>
+/// Start collecting data. Must be called after all instruments have
+/// been added so that we know which vars to subscribe to.
+/// </summary>
+void simvars::startDataLink()
+{
     dataLinkThread = new std::thread(dataLink, this);
 }
 
@@ -104,12 +172,47 @@ void simvars::loadSettings()
                     else if (_stricmp(name, DataLinkPort) == 0) {
                         globals.dataLinkPort = settingValue(value);
                     }
+                    else if (_stricmp(name, DataLinkRate) == 0) {
+                        globals.dataLinkRate = settingValue(value);
+                    }
+                    else if (_stricmp(name, DataLinkMulticast) == 0) {
+                        strcpy(globals.dataLinkMulticast, value);
+                    }
+                    else if (_stricmp(name, DataLinkMulticastPort) == 0) {
+                        globals.dataLinkMulticastPort = settingValue(value);
+                    }
+                    else if (_stricmp(name, DataLinkSmoothing) == 0) {
+                        globals.smoothing = (settingValue(value) == 1);
+                    }
+                    else if (_stricmp(name, DataLinkSmoothingDelay) == 0) {
+                        globals.smoothingDelayMs = settingValue(value);
+                    }
+                    else if (_stricmp(name, DataLinkSmoothingHorizon) == 0) {
+                        globals.smoothingHorizonMs = settingValue(value);
+                    }
+                    else if (_stricmp(name, DataLinkRecord) == 0) {
+                        strcpy(globals.recordDir, value);
+                    }
                 }
                 else if (_stricmp(group, MonitorGroup) == 0) {
                     if (_stricmp(name, MonitorStartOn) == 0) {
                         globals.startOnMonitor = atoi(value);
                     }
                 }
+                else if (_stricmp(group, RenderGroup) == 0) {
+                    if (_stricmp(name, RenderDirect) == 0) {
+                        globals.directRender = (settingValue(value) == 1);
+                    }
+                    else if (_stricmp(name, RenderShaders) == 0) {
+                        globals.shaders = (settingValue(value) == 1);
+                    }
+                    else if (_stricmp(name, RenderFrameRate) == 0) {
+                        globals.frameRate = settingValue(value);
+                    }
+                    else if (_stricmp(name, RenderIdleFrameRate) == 0) {
+                        globals.idleFrameRate = settingValue(value);
+                    }
+                }
                 else if (groupCount == 0 || strcmp(groups[groupCount - 1].name, group) != 0) {
                     // New group
                     strcpy(groups[groupCount].name, group);
@@ -165,7 +268,21 @@ void simvars::saveSettings()
         fprintf(outfile, "{\n");
         fprintf(outfile, "  \"%s\": {\n", DataLinkGroup);
         fprintf(outfile, "    \"%s\": \"%s\",\n", DataLinkHost, globals.dataLinkHost);
-        fprintf(outfile, "    \"%s\": %d\n", DataLinkPort, globals.dataLinkPort);
+        fprintf(outfile, "    \"%s\": %d,\n", DataLinkPort, globals.dataLinkPort);
+        fprintf(outfile, "    \"%s\": %d,\n", DataLinkRate, globals.dataLinkRate);
+        if (globals.dataLinkMulticast[0] != '\0') {
+            fprintf(outfile, "    \"%s\": \"%s\",\n", DataLinkMulticast, globals.dataLinkMulticast);
+            fprintf(outfile, "    \"%s\": %d,\n", DataLinkMulticastPort, globals.dataLinkMulticastPort);
+        }
+        fprintf(outfile, "    \"%s\": %s,\n", DataLinkSmoothing, globals.smoothing ? "true" : "false");
+        fprintf(outfile, "    \"%s\": %d,\n", DataLinkSmoothingDelay, globals.smoothingDelayMs);
+        if (globals.recordDir[0] != '\0') {
+            fprintf(outfile, "    \"%s\": %d,\n", DataLinkSmoothingHorizon, globals.smoothingHorizonMs);
+            fprintf(outfile, "    \"%s\": \"%s\"\n", DataLinkRecord, globals.recordDir);
+        }
+        else {
+            fprintf(outfile, "    \"%s\": %d\n", DataLinkSmoothingHorizon, globals.smoothingHorizonMs);
+        }
         fprintf(outfile, "  },\n");
 
         if (globals.startOnMonitor != 0) {
@@ -174,6 +291,13 @@ void simvars::saveSettings()
             fprintf(outfile, "  },\n");
         }
 
+        fprintf(outfile, "  \"%s\": {\n", RenderGroup);
+        fprintf(outfile, "    \"%s\": %d,\n", RenderFrameRate, globals.frameRate);
+        fprintf(outfile, "    \"%s\": %d,\n", RenderIdleFrameRate, globals.idleFrameRate);
+        fprintf(outfile, "    \"%s\": %s,\n", RenderDirect, globals.directRender ? "true" : "false");
+        fprintf(outfile, "    \"%s\": %s\n", RenderShaders, globals.shaders ? "true" : "false");
+        fprintf(outfile, "  },\n");
+
         int idx = 0;
         while (idx < groupCount)
         {
@@ -412,7 +536,7 @@ void simvars::adjustVar(double amount)
 
     if (varOffset[idx] >= 0) {
         // Update real SimVar variable
-        double *pVar = (double *)&simVars + varOffset[idx];
+        double *pVar = (double *)simVars + varOffset[idx];
         *pVar = varVal[idx];
     }
 }
@@ -437,7 +561,7 @@ char *simvars::view()
 
     if (globals.dataLinked && !globals.arranging) {
         // Update with real value
-        double *pVar = (double *)&simVars + varOffset[idx];
+        double *pVar = (double *)simVars + varOffset[idx];
         varVal[idx] = *pVar;
     }
 
@@ -477,23 +601,44 @@ void simvars::doKeypress(int keycode)
     }
 }
 
-void simvars::addVar(const char* group, const char* name, bool isBool, double scaling, double val)
+/// <summary>
+/// Convert SimVar name to address offset (number of doubles).
+/// This is also the field number used by the delta format.
+/// Returns -1 if the name is unknown.
+/// </summary>
+int simvars::getVarOffset(const char* name)
 {
-    // Convert SimVar name to address offset (number of doubles)
     int offset = 1;
-    for (int i = 0;; i++) {
-        if (SimVarDefs[i][0] == NULL) {
-            sprintf(globals.error, "Unknown SimVar name: %s - %s", group, name);
-            return;
-        }
-
+    for (int i = 0; SimVarDefs[i][0] != NULL; i++) {
         if (strcmp(SimVarDefs[i][0], name) == 0) {
-            break;
+            return offset;
         }
 
         offset++;
     }
 
+    return -1;
+}
+
+void simvars::addSmoothVar(const char* name, double wrapMin, double wrapRange)
+{
+    int offset = getVarOffset(name);
+    if (offset == -1) {
+        sprintf(globals.error, "Unknown SimVar name: %s", name);
+        return;
+    }
+
+    smoother.addVar(offset, wrapMin, wrapRange);
+}
+
+void simvars::addVar(const char* group, const char* name, bool isBool, double scaling, double val)
+{
+    int offset = getVarOffset(name);
+    if (offset == -1) {
+        sprintf(globals.error, "Unknown SimVar name: %s - %s", group, name);
+        return;
+    }
+
     // Must not already be added
     int idx = getVarIdx(offset);
     if (idx != -1)
@@ -510,6 +655,25 @@ void simvars::addVar(const char* group, const char* name, bool isBool, double sc
     varVal[varCount] = val;
 
     varCount++;
+
+    // Instrument needs this var from the data link
+    fields[offset / 32] |= 1u << (offset % 32);
+}
+
+/// <summary>
+/// An instrument reads this SimVar but doesn't own it, i.e. it has been
+/// added by a different instrument or is common. Makes sure the var is
+/// included in the subscription even if the owning instrument is disabled.
+/// </summary>
+void simvars::useVar(const char* group, const char* name)
+{
+    int offset = getVarOffset(name);
+    if (offset == -1) {
+        sprintf(globals.error, "Unknown SimVar name: %s - %s", group, name);
+        return;
+    }
+
+    fields[offset / 32] |= 1u << (offset % 32);
 }
 
 void simvars::addSetting(const char* group, const char* name)
@@ -647,9 +811,426 @@ void simvars::write(EVENT_ID eventId, double value)
     }
 }
 
+/// <summary>
+/// Called by the data link thread to make a new sample visible to the
+/// main thread. The sample is copied into the private write buffer which
+/// is then swapped with the shared buffer. Its timestamps (if any) go in
+/// the matching slot so they stay with the sample.
+/// </summary>
+void simvars::publish(const SimVars* latest, const SampleTimes* times)
+{
+    memcpy(&buffers[writeIdx], latest, sizeof(SimVars));
+    if (times) {
+        sampleTimes[writeIdx] = *times;
+    }
+    else {
+        sampleTimes[writeIdx] = SampleTimes();
+    }
+    writeIdx = sharedIdx.exchange(writeIdx | NewData, std::memory_order_acq_rel) & IndexMask;
+}
+
+/// <summary>
+/// Called by the main thread once per frame. If the data link thread has
+/// published a new sample since the last call, simVars is switched to it.
+/// Returns true if simVars changed.
+/// </summary>
+bool simvars::acquire()
+{
+    if ((sharedIdx.load(std::memory_order_relaxed) & NewData) == 0) {
+        return false;
+    }
+
+    readIdx = sharedIdx.exchange(readIdx, std::memory_order_acq_rel) & IndexMask;
+
+    if (globals.smoothing) {
+        smoother.addSample(&buffers[readIdx], &sampleTimes[readIdx]);
+        memcpy(&smoothed, &buffers[readIdx], sizeof(SimVars));
+        simVars = &smoothed;
+    }
+    else {
+        simVars = &buffers[readIdx];
+    }
+
+    return true;
+}
+
+/// <summary>
+/// Called by the main thread every frame after acquire to estimate
+/// fast moving vars for the time the frame will be shown.
+/// </summary>
+void simvars::smooth(int64_t renderTime)
+{
+    if (globals.smoothing && !globals.simulating && simVars == &smoothed) {
+        smoother.estimate(&smoothed, renderTime);
+    }
+}
+
+union DataLinkPacket {
+    DeltaHeader header;
+    char data[MaxDeltaSize];
+};
+
+// Everything the data link thread needs to keep between packets
+struct DataLinkState {
+    SOCKET sockfd;
+    SOCKET groupfd = INVALID_SOCKET;
+    sockaddr_in addr;
+
+    // Data is received into a private buffer and then published
+    // so the main thread never sees a partially written sample.
+    SimVars received;
+
+    // Deltas only make sense once we have had a keyframe. If we miss
+    // a delta we keep going but ask for a new keyframe.
+    uint32_t lastSequence = 0;
+    bool initialised = false;
+    bool haveKeyframe = false;
+    bool keyframeRequested = false;
+
+    // Subscribe mode renews the lease, poll mode requests each sample
+    bool subscribed;
+    int missedRenewals = 0;
+    bool dataSinceRenewal = true;
+    std::chrono::steady_clock::time_point renewTime;
+    bool pollPending = false;
+    std::chrono::steady_clock::time_point pollTime;
+    int64_t pollSentTime = 0;
+
+    // Timestamps for latency stats
+    SampleTimes times;
+
+    // Detect if sim is active by looking for rpm variance.
+    // Based on time rather than samples as the rate depends
+    // on the subscription.
+    double lastRpm = 0;
+    int64_t rpmChangedTime = 0;
+};
+
+/// <summary>
+/// Ask instrument-data-link to start (or stop if rate is 0) streaming
+/// SimVars to us. Has to be renewed before the lease expires.
+/// </summary>
+int subscribe(SOCKET sockfd, sockaddr_in* addr, int rate, int flags = 0)
+{
+    SubscribeRequest request;
+    request.rate = rate;
+    request.leaseMs = SubscribeLeaseMs;
+    request.keyframeInterval = KeyframeInterval;
+    request.flags = flags;
+    memcpy(request.fields, globals.simVars->getFields(), sizeof(request.fields));
+
+    if (globals.dataLinkMulticast[0] != '\0') {
+        // Ask data link to publish to our multicast group
+        inet_pton(AF_INET, globals.dataLinkMulticast, &request.multicastAddr);
+        request.multicastPort = globals.dataLinkMulticastPort;
+    }
+
+    return sendto(sockfd, (char*)&request, sizeof(request), 0, (SOCKADDR*)addr, sizeof(*addr));
+}
+
+/// <summary>
+/// Request a single sample from instrument-data-link.
+/// </summary>
+int poll(SOCKET sockfd, sockaddr_in* addr)
+{
+    long dataSize = sizeof(SimVars);
+    return sendto(sockfd, (char*)&dataSize, sizeof(long), 0, (SOCKADDR*)addr, sizeof(*addr));
+}
+
+/// <summary>
+/// Lets the instruments know the data link has gone quiet.
+/// </summary>
+void dataLinkLost(simvars* t, DataLinkState* s)
+{
+    // Data link may have restarted its sequence so resync on the next keyframe
+    s->haveKeyframe = false;
+
+    if (!globals.dataLinked) {
+        return;
+    }
+
+    globals.dataLinked = false;
+    globals.active = false;
+    globals.aircraft = globals.NO_AIRCRAFT;
+    strcpy(globals.lastAircraft, "");
+    s->received.cruiseSpeed = 0;
+    t->publish(&s->received);
+}
+
+/// <summary>
+/// Sends any renewal or poll that is due and returns the time we
+/// next need to wake up if no data arrives before then.
+/// </summary>
+std::chrono::steady_clock::time_point serviceDataLink(simvars* t, DataLinkState* s)
+{
+    auto now = std::chrono::steady_clock::now();
+
+    if (s->subscribed) {
+        if (now >= s->renewTime) {
+            if (s->dataSinceRenewal) {
+                s->missedRenewals = 0;
+            }
+            else {
+                dataLinkLost(t, s);
+
+                if (++s->missedRenewals > SubscribeRetries) {
+                    // Data link isn't streaming so check if it answers a poll instead
+                    poll(s->sockfd, &s->addr);
+                }
+            }
+
+            // Renew subscription well before lease expires
+            if (subscribe(s->sockfd, &s->addr, globals.dataLinkRate) <= 0) {
+                dataLinkLost(t, s);
+            }
+            s->renewTime = now + std::chrono::milliseconds(SubscribeLeaseMs / 3);
+            s->dataSinceRenewal = false;
+        }
+
+        return s->renewTime;
+    }
+
+    if (s->pollPending && now >= s->pollTime) {
+        // No reply in time
+        dataLinkLost(t, s);
+        s->pollPending = false;
+    }
+
+    if (!s->pollPending && now >= s->pollTime) {
+        // Poll instrument data link
+        if (poll(s->sockfd, &s->addr) > 0) {
+            s->pollSentTime = latency::now();
+            s->pollPending = true;
+            s->pollTime = now + std::chrono::milliseconds(PollTimeoutMs);
+        }
+        else {
+            dataLinkLost(t, s);
+            s->pollTime = now + std::chrono::milliseconds(PollTimeoutMs);
+        }
+    }
+
+    return s->pollTime;
+}
+
+/// <summary>
+/// Decodes a datagram from the data link into the received sample
+/// and passes it to the flight recorder, if running.
+/// Returns true if the sample has changed.
+/// </summary>
+bool receivePacket(DataLinkState* s, DataLinkPacket* packet, int bytes)
+{
+    char errMsg[256];
+
+    if (bytes >= (int)sizeof(DeltaHeader) && packet->header.magic == DeltaMagic) {
+        int gap = (int)(packet->header.sequence - s->lastSequence);
+        bool keyframe = (packet->header.flags & DeltaIsKeyframe) != 0;
+
+        if (gap <= 0 && s->haveKeyframe) {
+            // Duplicate or out of order (even a keyframe), already have newer data
+            return false;
+        }
+
+        if (!applyDelta(&s->received, packet->data, bytes)) {
+            printf("DataLink: Invalid delta received\n");
+            s->haveKeyframe = false;
+        }
+        else if (keyframe) {
+            s->haveKeyframe = true;
+            s->initialised = true;
+        }
+        else if (gap != 1) {
+            // Missed a delta so some fields may be stale until the next keyframe
+            s->haveKeyframe = false;
+        }
+
+        if (!s->haveKeyframe && !s->keyframeRequested) {
+            // Ask for a keyframe now rather than waiting for the next one
+            subscribe(s->sockfd, &s->addr, globals.dataLinkRate, SubscribeKeyframe);
+            s->keyframeRequested = true;
+        }
+        else if (s->haveKeyframe) {
+            s->keyframeRequested = false;
+        }
+
+        if (gap > 0 || keyframe) {
+            // Only a keyframe can move us back, e.g. the data link restarted
+            s->lastSequence = packet->header.sequence;
+        }
+        s->times.networkUs = deltaTimestamp() - packet->header.sendTime;
+        s->times.receiveTime = latency::now();
+
+        // Still waiting for the first keyframe?
+        if (!s->initialised) {
+            return false;
+        }
+
+        if (globals.recorder) {
+            globals.recorder->record(&s->received, s->times.receiveTime);
+        }
+        return true;
+    }
+
+    if (bytes == sizeof(SimVars)) {
+        memcpy(&s->received, packet->data, sizeof(SimVars));
+
+        // No sender timestamp so assume half the round trip
+        s->times.receiveTime = latency::now();
+        s->times.networkUs = s->pollPending ? (s->times.receiveTime - s->pollSentTime) / 2 : -1;
+
+        s->pollPending = false;
+        s->pollTime = std::chrono::steady_clock::now() + std::chrono::milliseconds(PollIntervalMs);
+
+        if (globals.recorder) {
+            globals.recorder->record(&s->received, s->times.receiveTime);
+        }
+        return true;
+    }
+
+    if (bytes > 0 && s->subscribed) {
+        // Older data link replied with its data size so doesn't understand subscribe
+        printf("DataLink: Subscribe not supported by data link, polling instead\n");
+        s->subscribed = false;
+        s->pollPending = false;
+        s->pollTime = std::chrono::steady_clock::now();
+    }
+    else if (bytes > 0) {
+        long actualSize;
+        memcpy(&actualSize, packet->data, sizeof(long));
+        sprintf(errMsg, "DataLink: Requested %ld bytes but server has %ld bytes\n", (long)sizeof(SimVars), actualSize);
+        fatalError(errMsg);
+    }
+
+    return false;
+}
+
+/// <summary>
+/// Publishes the latest sample after a batch of packets has been received.
+/// </summary>
+void sampleReceived(simvars* t, DataLinkState* s)
+{
+    bool wasIdle = !globals.dataLinked || !globals.active;
+    globals.dataLinked = true;
+    globals.connected = (s->received.connected == 1);
+
+    if (s->subscribed && s->missedRenewals > SubscribeRetries) {
+        // Data link answered a poll but never streamed
+        printf("DataLink: Subscribe not supported by data link, polling instead\n");
+        s->subscribed = false;
+    }
+    s->dataSinceRenewal = true;
+
+    // Activate screensaver?
+    if (s->received.rpmEngine != s->lastRpm || s->rpmChangedTime == 0) {
+        s->rpmChangedTime = s->times.receiveTime;
+        s->lastRpm = s->received.rpmEngine;
+    }
+    globals.active = (s->times.receiveTime - s->rpmChangedTime < ScreensaverIdleMs * 1000LL);
+
+    if (wasIdle && globals.active && globals.frameScheduler) {
+        // Sim has come back to life
+        globals.frameScheduler->wake();
+    }
+
+    // Identify aircraft
+    if (strcmp(s->received.aircraft, globals.lastAircraft) != 0) {
+        if (strcmp(s->received.aircraft, globals.Cessna_172_Text) == 0) {
+            globals.aircraft = globals.CESSNA_172;
+        }
+        else if (strcmp(s->received.aircraft, globals.Savage_Cub_Text) == 0) {
+            globals.aircraft = globals.SAVAGE_CUB;
+        }
+        else {
+            globals.aircraft = globals.CESSNA_152;
+        }
+
+        strcpy(globals.lastAircraft, s->received.aircraft);
+    }
+
+    s->times.sequence++;
+    t->publish(&s->received, &s->times);
+}
+
+#ifndef _WIN32
+/// <summary>
+/// Returns true if the datagram is a full sample rather than a delta.
+/// A delta can be the same size as a full sample so check its magic
+/// first, as receivePacket does.
+/// </summary>
+bool isFullSample(DataLinkPacket* packet, int bytes)
+{
+    if (bytes >= (int)sizeof(DeltaHeader) && packet->header.magic == DeltaMagic) {
+        return false;
+    }
+    return bytes == sizeof(SimVars);
+}
+
+/// <summary>
+/// Reads every datagram queued on the socket, a batch at a time, so
+/// a burst after a stall is processed in one go. Deltas are applied in
+/// the order they arrived (each one builds on the last) but a full
+/// sample is only copied if no newer one is queued behind it.
+/// Returns true if the sample has changed.
+/// </summary>
+bool drainSocket(DataLinkState* s, SOCKET fd, DataLinkPacket* packets, mmsghdr* msgs, iovec* iovecs)
+{
+    bool newSample = false;
+    int count;
+
+    do {
+        for (int i = 0; i < DrainBatch; i++) {
+            iovecs[i].iov_base = packets[i].data;
+            iovecs[i].iov_len = sizeof(DataLinkPacket);
+            memset(&msgs[i].msg_hdr, 0, sizeof(msgs[i].msg_hdr));
+            msgs[i].msg_hdr.msg_iov = &iovecs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+
+        count = recvmmsg(fd, msgs, DrainBatch, MSG_DONTWAIT, NULL);
+        if (count <= 0) {
+            break;
+        }
+
+        int lastFull = -1;
+        for (int i = 0; i < count; i++) {
+            if (isFullSample(&packets[i], msgs[i].msg_len)) {
+                lastFull = i;
+            }
+        }
+
+        for (int i = 0; i < count; i++) {
+            if (i != lastFull && isFullSample(&packets[i], msgs[i].msg_len)) {
+                // Superseded by a newer sample in the same batch but
+                // the flight recorder still wants it
+                if (globals.recorder) {
+                    globals.recorder->record((SimVars*)packets[i].data, latency::now());
+                }
+                continue;
+            }
+            if (receivePacket(s, &packets[i], msgs[i].msg_len)) {
+                newSample = true;
+            }
+        }
+    } while (count == DrainBatch);
+
+    return newSample;
+}
+#endif
+
 /// <summary>
 /// A separate thread constantly collects the latest
 /// SimVar values from instrument-data-link.
+///
+/// In subscribe mode the data link streams samples to us at the
+/// requested rate and we only need to renew the subscription. If the
+/// data link doesn't support this we fall back to polling, i.e. send
+/// a request and wait for the reply.
+///
+/// If a multicast group is configured we join it and the data link
+/// publishes each sample once to the group for all panels to share.
+///
+/// On Linux the thread sleeps in epoll until a datagram arrives or a
+/// timerfd fires for the next renewal or poll, then drains everything
+/// queued and publishes once.
 /// </summary>
 void dataLink(simvars* t)
 {
@@ -664,120 +1245,185 @@ void dataLink(simvars* t)
     }
 #endif
 
+    DataLinkState* s = new DataLinkState();
+
     // Create a UDP socket
-    SOCKET sockfd;
-    if ((sockfd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP)) == INVALID_SOCKET) {
+    if ((s->sockfd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP)) == INVALID_SOCKET) {
         fatalError("DataLink: Failed to create UDP socket");
     }
 
     int opt = 1;
-    setsockopt(sockfd, SOL_SOCKET, SO_REUSEADDR, (char*)&opt, sizeof(opt));
+    setsockopt(s->sockfd, SOL_SOCKET, SO_REUSEADDR, (char*)&opt, sizeof(opt));
 
-    sockaddr_in addr;
-    addr.sin_family = AF_INET;
-    addr.sin_port = htons(globals.dataLinkPort);
-    if (inet_pton(AF_INET, globals.dataLinkHost, &addr.sin_addr) <= 0)
+    s->addr.sin_family = AF_INET;
+    s->addr.sin_port = htons(globals.dataLinkPort);
+    if (inet_pton(AF_INET, globals.dataLinkHost, &s->addr.sin_addr) <= 0)
     {
         sprintf(errMsg, "DataLink: Invalid server address: %s\n", globals.dataLinkHost);
         fatalError(errMsg);
     }
 
-    timeval timeout;
-    timeout.tv_sec = 0;
-    timeout.tv_usec = 500000;
+    // Samples published to a multicast group arrive on a separate socket
+    // so several panels on the same host can share the group port.
+    if (globals.dataLinkMulticast[0] != '\0') {
+        if ((s->groupfd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP)) == INVALID_SOCKET) {
+            fatalError("DataLink: Failed to create multicast socket");
+        }
+        setsockopt(s->groupfd, SOL_SOCKET, SO_REUSEADDR, (char*)&opt, sizeof(opt));
 
-    long dataSize = sizeof(SimVars);
-    long actualSize;
-    int bytes;
+        sockaddr_in groupAddr;
+        memset(&groupAddr, 0, sizeof(groupAddr));
+        groupAddr.sin_family = AF_INET;
+        groupAddr.sin_port = htons(globals.dataLinkMulticastPort);
+        groupAddr.sin_addr.s_addr = htonl(INADDR_ANY);
 
-    // Detect if sim is active by looking for rpm variance.
-    // Want about 30 seconds of inactivity before we activate
-    // screensaver.
-    double lastRpm = 0;
-    int rpmMatch = 0;
+        if (bind(s->groupfd, (SOCKADDR*)&groupAddr, sizeof(groupAddr)) != 0) {
+            sprintf(errMsg, "DataLink: Failed to bind to multicast port %d\n", globals.dataLinkMulticastPort);
+            fatalError(errMsg);
+        }
+
+        ip_mreq group;
+        group.imr_interface.s_addr = htonl(INADDR_ANY);
+        if (inet_pton(AF_INET, globals.dataLinkMulticast, &group.imr_multiaddr) <= 0) {
+            sprintf(errMsg, "DataLink: Invalid multicast group: %s\n", globals.dataLinkMulticast);
+            fatalError(errMsg);
+        }
+
+        if (setsockopt(s->groupfd, IPPROTO_IP, IP_ADD_MEMBERSHIP, (char*)&group, sizeof(group)) != 0) {
+            sprintf(errMsg, "DataLink: Failed to join multicast group %s\n", globals.dataLinkMulticast);
+            fatalError(errMsg);
+        }
+    }
 
     // Detect current aircraft and convert to an int.
     // We do this here to save having to do it for each instrument.
     globals.aircraft = globals.NO_AIRCRAFT;
     strcpy(globals.lastAircraft, "");
 
-    int loop = 0;
+    // Use subscribe mode if a rate has been configured
+    s->subscribed = (globals.dataLinkRate > 0);
+    s->renewTime = std::chrono::steady_clock::now();
+    s->pollTime = s->renewTime;
+
+#ifdef _WIN32
+    DataLinkPacket packet;
+
     while (!globals.quit) {
-        // Poll instrument data link
-        bytes = sendto(sockfd, (char*)&dataSize, sizeof(long), 0, (SOCKADDR*)&addr, sizeof(addr));
+        auto wakeTime = serviceDataLink(t, s);
 
-        if (bytes > 0) {
-            fd_set fds;
-            FD_ZERO(&fds);
-            FD_SET(sockfd, &fds);
+        // Wait for the next sample or until a renewal or poll is due
+        long long waitUs = std::chrono::duration_cast<std::chrono::microseconds>(wakeTime - std::chrono::steady_clock::now()).count();
+        if (waitUs > 500000) {
+            waitUs = 500000;
+        }
+        else if (waitUs < 0) {
+            waitUs = 0;
+        }
 
-            int sel = select(FD_SETSIZE, &fds, 0, 0, &timeout);
-            if (sel > 0) {
-                // Receive latest data
-                bytes = recv(sockfd, (char*)&t->simVars, dataSize, 0);
+        timeval timeout;
+        timeout.tv_sec = 0;
+        timeout.tv_usec = (long)waitUs;
 
-                if (bytes == dataSize) {
-                    globals.dataLinked = true;
-                    globals.connected = (t->simVars.connected == 1);
+        fd_set fds;
+        FD_ZERO(&fds);
+        FD_SET(s->sockfd, &fds);
+        if (s->groupfd != INVALID_SOCKET) {
+            FD_SET(s->groupfd, &fds);
+        }
 
-                    // Activate screensaver?
-                    if (t->simVars.rpmEngine == lastRpm) {
-                        rpmMatch++;
-                    }
-                    else {
-                        rpmMatch = 0;
-                        lastRpm = t->simVars.rpmEngine;
-                    }
-                    globals.active = (rpmMatch < 3000);
-
-                    // Identify aircraft
-                    if (strcmp(t->simVars.aircraft, globals.lastAircraft) != 0) {
-                        if (strcmp(t->simVars.aircraft, globals.Cessna_172_Text) == 0) {
-                            globals.aircraft = globals.CESSNA_172;
-                        }
-                        else if (strcmp(t->simVars.aircraft, globals.Savage_Cub_Text) == 0) {
-                            globals.aircraft = globals.SAVAGE_CUB;
-                        }
-                        else {
-                            globals.aircraft = globals.CESSNA_152;
-                        }
-
-                        strcpy(globals.lastAircraft, t->simVars.aircraft);
-                    }
-                }
-                else if (bytes > 0) {
-                    memcpy(&actualSize, &t->simVars, sizeof(long));
-                    sprintf(errMsg, "DataLink: Requested %ld bytes but server has %ld bytes\n", dataSize, actualSize);
-                    fatalError(errMsg);
-                }
-                else {
-                    bytes = SOCKET_ERROR;
-                }
+        if (select(FD_SETSIZE, &fds, 0, 0, &timeout) > 0) {
+            SOCKET readfd = s->sockfd;
+            if (s->groupfd != INVALID_SOCKET && FD_ISSET(s->groupfd, &fds)) {
+                readfd = s->groupfd;
             }
-            else {
-                bytes = SOCKET_ERROR;
+
+            // Receive latest data (full SimVars or a delta)
+            int bytes = recv(readfd, packet.data, sizeof(packet), 0);
+            if (receivePacket(s, &packet, bytes)) {
+                sampleReceived(t, s);
             }
         }
-        else {
-            bytes = SOCKET_ERROR;
+    }
+#else
+    int epollfd = epoll_create1(0);
+    int timerfd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK);
+    if (epollfd == -1 || timerfd == -1) {
+        fatalError("DataLink: Failed to create epoll or timer");
+    }
+
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.fd = s->sockfd;
+    epoll_ctl(epollfd, EPOLL_CTL_ADD, s->sockfd, &event);
+    event.data.fd = timerfd;
+    epoll_ctl(epollfd, EPOLL_CTL_ADD, timerfd, &event);
+    if (s->groupfd != INVALID_SOCKET) {
+        event.data.fd = s->groupfd;
+        epoll_ctl(epollfd, EPOLL_CTL_ADD, s->groupfd, &event);
+    }
+
+    DataLinkPacket* packets = new DataLinkPacket[DrainBatch];
+    mmsghdr msgs[DrainBatch];
+    iovec iovecs[DrainBatch];
+    epoll_event events[3];
+
+    while (!globals.quit) {
+        auto wakeTime = serviceDataLink(t, s);
+
+        // Timer uses the same monotonic clock as steady_clock. Also wake
+        // regularly so we notice when the panel is quitting.
+        auto maxWake = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+        if (wakeTime > maxWake) {
+            wakeTime = maxWake;
         }
+        long long wakeNs = std::chrono::duration_cast<std::chrono::nanoseconds>(wakeTime.time_since_epoch()).count();
+
+        itimerspec timer;
+        memset(&timer, 0, sizeof(timer));
+        timer.it_value.tv_sec = wakeNs / 1000000000;
+        timer.it_value.tv_nsec = wakeNs % 1000000000;
+        if (timer.it_value.tv_sec == 0 && timer.it_value.tv_nsec == 0) {
+            // Zero would disarm the timer
+            timer.it_value.tv_nsec = 1;
+        }
+        timerfd_settime(timerfd, TFD_TIMER_ABSTIME, &timer, NULL);
+
+        int count = epoll_wait(epollfd, events, 3, -1);
+        bool newSample = false;
 
-        if (bytes == SOCKET_ERROR && globals.dataLinked) {
-            globals.dataLinked = false;
-            globals.active = false;
-            globals.aircraft = globals.NO_AIRCRAFT;
-            strcpy(globals.lastAircraft, "");
-            globals.simVars->simVars.cruiseSpeed = 0;
+        for (int i = 0; i < count; i++) {
+            if (events[i].data.fd == timerfd) {
+                // Clear the expiry, serviceDataLink does the work
+                uint64_t expirations;
+                if (read(timerfd, &expirations, sizeof(expirations)) < 0) {
+                    continue;
+                }
+            }
+            else if (drainSocket(s, events[i].data.fd, packets, msgs, iovecs)) {
+                newSample = true;
+            }
         }
 
-#ifdef _WIN32
-        Sleep(10);
-#else
-        usleep(10000);
+        if (newSample) {
+            sampleReceived(t, s);
+        }
+    }
+
+    delete[] packets;
+    close(timerfd);
+    close(epollfd);
 #endif
+
+    if (s->subscribed) {
+        // Tell data link to stop streaming
+        subscribe(s->sockfd, &s->addr, 0);
     }
 
-    closesocket(sockfd);
+    if (s->groupfd != INVALID_SOCKET) {
+        closesocket(s->groupfd);
+    }
+    closesocket(s->sockfd);
+    delete s;
 
 #ifdef _WIN32
     WSACleanup();
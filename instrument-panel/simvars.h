@@ -2,6 +2,7 @@
 #define _SIMVARS_H_
 
 #include <thread>
+#include <atomic>
 #ifdef _WIN32
 #include <Windows.h>
 #else
@@ -16,16 +17,36 @@ typedef int SOCKET;
 #endif
 #include "globals.h"
 #include "simvarDefs.h"
+#include "latency.h"
+#include "interpolator.h"
 
 extern globalVars globals;
 
 class simvars {
 public:
-    SimVars simVars;
+    // Latest consistent snapshot (only changes when acquire is called)
+    SimVars* simVars;
 
 private:
     std::thread* dataLinkThread = NULL;
 
+    // Triple buffer shared with the data link thread. The main thread
+    // reads simVars, the data link thread writes to the buffer at writeIdx
+    // and the remaining buffer is handed between them with a single atomic
+    // exchange so no locking is required.
+    static const int NewData = 4;
+    static const int IndexMask = 3;
+    SimVars buffers[3];
+    SampleTimes sampleTimes[3];
+    int readIdx = 0;
+    int writeIdx = 1;
+    std::atomic<int> sharedIdx{ 2 };
+
+    // With smoothing on, simVars points to a copy of the latest sample
+    // with fast moving vars estimated for the time the frame is shown.
+    interpolator smoother;
+    SimVars smoothed;
+
     SOCKET writeSockfd = INVALID_SOCKET;
     sockaddr_in writeAddr;
     struct {
@@ -53,17 +74,27 @@ private:
     
     int groupCount = 0;
     struct SettingsGroup groups[64] = {};
+
+    // Vars (delta field numbers) to subscribe to
+    uint32_t fields[MaxSimVarFields / 32] = {};
     
 public:
     simvars();
     ~simvars();
     char *view();
     void doKeypress(int keycode);
+    void startDataLink();
     void addVar(const char* group, const char* name, bool isBool, double scaling, double val);
+    void useVar(const char* group, const char* name);
+    const uint32_t* getFields() { return fields; }
     void addSetting(const char* group, const char* name);
     long* readSettings(const char* group, int defaultX, int defaultY, int defaultSize);
     bool isEnabled(const char* group);
     void write(EVENT_ID eventId, double value = 0);
+    void publish(const SimVars* latest, const SampleTimes* times = NULL);
+    const SampleTimes* getSampleTimes() { return &sampleTimes[readIdx]; }
+    bool acquire();
+    void smooth(int64_t renderTime);
     
 private:
     void loadSettings();
@@ -73,6 +104,8 @@ private:
     void showCentre(FILE* outfile, const char* group, int x, int y, int size);
     void saveGroup(FILE* outfile, const char* group);
     int getVarIdx(int num);
+    int getVarOffset(const char* name);
+    void addSmoothVar(const char* name, double wrapMin = 0, double wrapRange = 0);
     bool isCorrectType(int idx);
     void getNextVar();
     void getPrevVar();
@@ -0,0 +1,44 @@
+echo Building render-bench
+cd render-bench
+g++ -lpthread -lallegro -lallegro_image -lallegro_font \
+    -o render-bench \
+    -I . \
+    -I ../instrument-panel \
+    -I ../instrument-panel/instruments \
+    renderBench.cpp \
+    knobsStub.cpp \
+    ../instrument-panel/simvarDefs.cpp \
+    ../instrument-panel/simvarDelta.cpp \
+    ../instrument-panel/latency.cpp \
+    ../instrument-panel/interpolator.cpp \
+    ../instrument-panel/flightRecorder.cpp \
+    ../instrument-panel/atlas.cpp \
+    ../instrument-panel/drawing.cpp \
+    ../instrument-panel/scheduler.cpp \
+    ../instrument-panel/preloader.cpp \
+    ../instrument-panel/bitmapPack.cpp \
+    ../instrument-panel/bitmapCache.cpp \
+    ../instrument-panel/simvars.cpp \
+    ../instrument-panel/instrument.cpp \
+    ../instrument-panel/instruments/adf.cpp \
+    ../instrument-panel/instruments/adi.cpp \
+    ../instrument-panel/instruments/adiLearjet.cpp \
+    ../instrument-panel/instruments/alt.cpp \
+    ../instrument-panel/instruments/annunciator.cpp \
+    ../instrument-panel/instruments/asi.cpp \
+    ../instrument-panel/instruments/digitalClock.cpp \
+    ../instrument-panel/instruments/egt.cpp \
+    ../instrument-panel/instruments/fuel.cpp \
+    ../instrument-panel/instruments/hi.cpp \
+    ../instrument-panel/instruments/nav.cpp \
+    ../instrument-panel/instruments/oil.cpp \
+    ../instrument-panel/instruments/rpm.cpp \
+    ../instrument-panel/instruments/tc.cpp \
+    ../instrument-panel/instruments/trimFlaps.cpp \
+    ../instrument-panel/instruments/vac.cpp \
+    ../instrument-panel/instruments/vor1.cpp \
+    ../instrument-panel/instruments/vor2.cpp \
+    ../instrument-panel/instruments/vsi.cpp \
+    || exit
+echo Done
+echo Run from instrument-panel with: ../render-bench/render-bench
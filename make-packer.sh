@@ -0,0 +1,9 @@
+echo Building asset-packer
+cd asset-packer
+g++ -lallegro -lallegro_image -o asset-packer \
+    -I . \
+    -I ../instrument-panel \
+    assetPacker.cpp \
+    || exit
+echo Done
+echo Run with: asset-packer/asset-packer
@@ -0,0 +1,13 @@
+echo Building data-link-stub
+cd data-link-stub
+g++ -lpthread -o data-link-stub \
+    -I . \
+    -I ../instrument-panel \
+    dataLinkStub.cpp \
+    ../instrument-panel/simvarDefs.cpp \
+    ../instrument-panel/simvarDelta.cpp \
+    ../instrument-panel/latency.cpp \
+    ../instrument-panel/flightRecorder.cpp \
+    || exit
+echo Done
+echo Run with: data-link-stub/data-link-stub
@@ -5,6 +5,16 @@ g++ -lwiringPi -lpthread -lallegro -lallegro_image -lallegro_font \
     -I . \
     -I instruments \
     simvarDefs.cpp \
+    simvarDelta.cpp \
+    latency.cpp \
+    interpolator.cpp \
+    flightRecorder.cpp \
+    atlas.cpp \
+    drawing.cpp \
+    scheduler.cpp \
+    preloader.cpp \
+    bitmapPack.cpp \
+    bitmapCache.cpp \
     simvars.cpp \
     knobs.cpp \
     instrument.cpp \
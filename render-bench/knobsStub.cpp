@@ -0,0 +1,24 @@
+/*
+ * Stands in for knobs.cpp so the bench builds without wiringPi, which
+ * only exists on Raspberry Pi. The bench never creates any hardware knobs
+ * (globals.hardwareKnobs stays NULL) so none of this is ever called.
+ */
+#include "knobs.h"
+
+knobs::knobs()
+{
+}
+
+knobs::~knobs()
+{
+}
+
+int knobs::add(int gpio1, int gpio2, int minVal, int maxVal, int startVal)
+{
+    return -1;
+}
+
+int knobs::read(int knobNum)
+{
+    return 0;
+}
@@ -0,0 +1,448 @@
+/*
+ * Render Bench
+ * Measures what each instrument costs to update and render so a change
+ * to one gauge can be shown to have helped (or hurt).
+ *
+ * Every instrument class is created on its own at each size in the
+ * sweep, with shadows on and off and in each of its variants (e.g. the
+ * fast plane ASI and ALT). Scripted SimVars sweep every needle through
+ * its range so the instrument has to be redrawn on every frame. update
+ * (including its fixed steps) and render are timed separately.
+ *
+ * Runs headless, i.e. everything is drawn into memory bitmaps by the CPU,
+ * so it works on a server without a monitor. Run from the instrument-panel
+ * directory so the bitmaps are found. No settings are read or saved.
+ *
+ * The report is JSON with the p50 and p99 times (microseconds) and the
+ * draw counts per frame for every run.
+ *
+ * Usage: render-bench [options]
+ *
+ *   -n frames ...... Frames timed per run (default 2000)
+ *   -s sizes ....... Comma separated sizes (default 200,300,400,600,800)
+ *   -i names ....... Comma separated instruments, e.g. "ASI,ADI Learjet"
+ *                    (default all)
+ *   -d ............. Draw straight to the screen bitmap (Direct Render)
+ *                    instead of compositing
+ *   -o file ........ Write the report to a file instead of stdout
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <list>
+#include <vector>
+#include <algorithm>
+#include <allegro5/allegro.h>
+#include <allegro5/allegro_font.h>
+#include <allegro5/allegro_image.h>
+#include "globals.h"
+#include "simvars.h"
+#include "instrument.h"
+#include "drawing.h"
+#include "atlas.h"
+#include "bitmapPack.h"
+#include "bitmapCache.h"
+#include "adi.h"
+#include "adiLearjet.h"
+#include "asi.h"
+#include "alt.h"
+#include "vor1.h"
+#include "tc.h"
+#include "hi.h"
+#include "vsi.h"
+#include "vor2.h"
+#include "trimFlaps.h"
+#include "rpm.h"
+#include "adf.h"
+#include "annunciator.h"
+#include "digitalClock.h"
+#include "fuel.h"
+#include "egt.h"
+#include "vac.h"
+#include "oil.h"
+#include "nav.h"
+
+// Frames before timing starts (resize, atlas and first composite)
+const int WarmupFrames = 30;
+
+// Frames for every needle to sweep its whole range and back
+const int SweepFrames = 300;
+
+const int MaxSizes = 16;
+const int SlowCruiseSpeed = 120;
+const int FastCruiseSpeed = 250;
+
+struct globalVars globals;
+
+struct Case {
+    const char* name;
+    const char* variant;
+    instrument* (*create)(int xPos, int yPos, int size);
+    int cruiseSpeed;
+    int aircraft;
+};
+
+// The settings name (see setName) of every instrument and its variants
+const Case Cases[] = {
+    { "ASI", "slow", [](int x, int y, int s) -> instrument* { return new asi(x, y, s); }, SlowCruiseSpeed, globalVars::CESSNA_152 },
+    { "ASI", "cub", [](int x, int y, int s) -> instrument* { return new asi(x, y, s); }, SlowCruiseSpeed, globalVars::SAVAGE_CUB },
+    { "ASI", "fast", [](int x, int y, int s) -> instrument* { return new asi(x, y, s); }, FastCruiseSpeed, globalVars::CESSNA_152 },
+    { "ADI", "", [](int x, int y, int s) -> instrument* { return new adi(x, y, s); }, SlowCruiseSpeed, globalVars::CESSNA_152 },
+    { "ADI Learjet", "", [](int x, int y, int s) -> instrument* { return new adiLearjet(x, y, s); }, SlowCruiseSpeed, globalVars::CESSNA_152 },
+    { "ALT", "slow", [](int x, int y, int s) -> instrument* { return new alt(x, y, s); }, SlowCruiseSpeed, globalVars::CESSNA_152 },
+    { "ALT", "fast", [](int x, int y, int s) -> instrument* { return new alt(x, y, s); }, FastCruiseSpeed, globalVars::CESSNA_152 },
+    { "VOR1", "", [](int x, int y, int s) -> instrument* { return new vor1(x, y, s); }, SlowCruiseSpeed, globalVars::CESSNA_152 },
+    { "TC", "", [](int x, int y, int s) -> instrument* { return new tc(x, y, s); }, SlowCruiseSpeed, globalVars::CESSNA_152 },
+    { "HI", "", [](int x, int y, int s) -> instrument* { return new hi(x, y, s); }, SlowCruiseSpeed, globalVars::CESSNA_152 },
+    { "VSI", "", [](int x, int y, int s) -> instrument* { return new vsi(x, y, s); }, SlowCruiseSpeed, globalVars::CESSNA_152 },
+    { "VOR2", "", [](int x, int y, int s) -> instrument* { return new vor2(x, y, s); }, SlowCruiseSpeed, globalVars::CESSNA_152 },
+    { "Trim Flaps", "", [](int x, int y, int s) -> instrument* { return new trimFlaps(x, y, s); }, SlowCruiseSpeed, globalVars::CESSNA_152 },
+    { "RPM", "slow", [](int x, int y, int s) -> instrument* { return new rpm(x, y, s); }, SlowCruiseSpeed, globalVars::CESSNA_152 },
+    { "RPM", "cub", [](int x, int y, int s) -> instrument* { return new rpm(x, y, s); }, SlowCruiseSpeed, globalVars::SAVAGE_CUB },
+    { "ADF", "", [](int x, int y, int s) -> instrument* { return new adf(x, y, s); }, SlowCruiseSpeed, globalVars::CESSNA_152 },
+    { "Annunciator", "", [](int x, int y, int s) -> instrument* { return new annunciator(x, y, s); }, SlowCruiseSpeed, globalVars::CESSNA_152 },
+    { "Digital Clock", "", [](int x, int y, int s) -> instrument* { return new digitalClock(x, y, s); }, SlowCruiseSpeed, globalVars::CESSNA_152 },
+    { "Fuel", "", [](int x, int y, int s) -> instrument* { return new fuel(x, y, s); }, SlowCruiseSpeed, globalVars::CESSNA_152 },
+    { "EGT", "", [](int x, int y, int s) -> instrument* { return new egt(x, y, s); }, SlowCruiseSpeed, globalVars::CESSNA_152 },
+    { "VAC", "", [](int x, int y, int s) -> instrument* { return new vac(x, y, s); }, SlowCruiseSpeed, globalVars::CESSNA_152 },
+    { "Oil", "", [](int x, int y, int s) -> instrument* { return new oil(x, y, s); }, SlowCruiseSpeed, globalVars::CESSNA_152 },
+    { "Nav", "", [](int x, int y, int s) -> instrument* { return new nav(x, y, s); }, SlowCruiseSpeed, globalVars::CESSNA_152 },
+};
+
+int frameCount = 2000;
+int sizes[MaxSizes] = { 200, 300, 400, 600, 800 };
+int sizeCount = 5;
+const char* onlyNames = NULL;
+
+/// <summary>
+/// Called by simvars if the SimVar definitions are broken
+/// </summary>
+void showError(const char* msg)
+{
+    fprintf(stderr, "%s\n", msg);
+}
+
+void fatalError(const char* msg)
+{
+    showError(msg);
+    exit(1);
+}
+
+/// <summary>
+/// Sweeps every needle through its range and back. Phase goes from 0 to
+/// 1 over a sweep.
+/// </summary>
+void sweep(SimVars* simVars, double phase)
+{
+    double up = phase < 0.5 ? phase * 2 : 2 - phase * 2;
+    double wave = sin(phase * 2 * ALLEGRO_PI);
+
+    simVars->connected = 1;
+    simVars->asiAirspeed = simVars->cruiseSpeed >= globals.FastPlaneSpeed ? 350 * up : 200 * up;
+    simVars->asiMachSpeed = simVars->asiAirspeed / 661.5;
+    simVars->asiAirspeedCal = -14 + 28 * up;
+    simVars->altAltitude = 20000 * up;
+    simVars->altKollsman = 28.5 + 2 * up;
+    simVars->adiPitch = 30 * wave;
+    simVars->adiBank = 90 * wave;
+    simVars->hiHeading = 360 * phase;
+    simVars->vsiVerticalSpeed = 2000 * wave;
+    simVars->tcRate = 6 * wave;
+    simVars->tcBall = wave;
+    simVars->tfElevatorTrim = wave;
+    simVars->tfFlapsCount = 4;
+    simVars->tfFlapsIndex = (int)(4 * up);
+    simVars->dcUtcSeconds = 86400 * phase;
+    simVars->dcLocalSeconds = 86400 * phase;
+    simVars->dcFlightSeconds = 3600 * phase;
+    simVars->rpmEngine = 3000 * up;
+    simVars->rpmPercent = 110 * up;
+    simVars->rpmElapsedTime = 9999 * phase;
+    simVars->fuelLeft = 26 * up;
+    simVars->fuelRight = 26 * (1 - up);
+    simVars->vor1Obs = 360 * phase;
+    simVars->vor1RadialError = 10 * wave;
+    simVars->vor1GlideSlopeError = 0.7 * wave;
+    simVars->vor1ToFrom = 1;
+    simVars->vor1GlideSlopeFlag = 1;
+    simVars->vor2Obs = 360 * phase;
+    simVars->vor2RadialError = 10 * wave;
+    simVars->vor2ToFrom = 1;
+    simVars->adfRadial = 360 * phase;
+    simVars->adfCard = 360 * (1 - phase);
+    simVars->oilTemp = 250 * up;
+    simVars->oilPress = 115 * up;
+    simVars->exhaustGasTemp = 1600 * up;
+    simVars->engineFuelFlow = 19 * up;
+    simVars->suctionPressure = 10 * up;
+    simVars->gearLeftPos = 100 * up;
+    simVars->gearCentrePos = 100 * up;
+    simVars->gearRightPos = 100 * up;
+}
+
+struct Stats {
+    double p50;
+    double p99;
+    double mean;
+};
+
+Stats summarise(std::vector<double>& samples)
+{
+    Stats stats = { 0, 0, 0 };
+    if (samples.empty()) {
+        return stats;
+    }
+
+    std::sort(samples.begin(), samples.end());
+    int count = (int)samples.size();
+    stats.p50 = samples[count / 2];
+    stats.p99 = samples[std::min(count - 1, count * 99 / 100)];
+
+    for (double sample : samples) {
+        stats.mean += sample;
+    }
+    stats.mean /= count;
+
+    return stats;
+}
+
+double elapsedUs(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// <summary>
+/// Creates the instrument, runs it for the warmup and timed frames and
+/// writes a JSON object with the results.
+/// </summary>
+void run(FILE* outfile, const Case* benchCase, int size, bool shadows, bool first)
+{
+    // Instruments can only be added once per simvars
+    globals.simVars = new simvars();
+    globals.aircraft = benchCase->aircraft;
+    globals.enableShadows = shadows;
+
+    SimVars* simVars = globals.simVars->simVars;
+    simVars->cruiseSpeed = benchCase->cruiseSpeed;
+    sweep(simVars, 0);
+
+    // Leave room for instruments that draw outside their size
+    std::list<instrument*> instruments;
+    instrument* inst = benchCase->create(size / 2, size / 2, size);
+    instruments.push_back(inst);
+
+    std::vector<double> updateUs;
+    std::vector<double> renderUs;
+    std::vector<double> draws;
+    std::vector<double> drawCalls;
+    double textureBinds = 0;
+    double pixels = 0;
+
+    for (int frame = 0; frame < WarmupFrames + frameCount; frame++) {
+        sweep(simVars, (double)(frame % SweepFrames) / SweepFrames);
+
+        auto start = std::chrono::steady_clock::now();
+        inst->update();
+        for (int i = 0; i < globals.frameSteps; i++) {
+            inst->step();
+        }
+        double updateTime = elapsedUs(start);
+
+        if (globals.atlasStale) {
+            globals.spriteAtlas->build(&instruments);
+        }
+
+        al_set_target_bitmap(globals.screen);
+        DrawCounts before = drawCounts();
+
+        start = std::chrono::steady_clock::now();
+        holdDrawing(true);
+        inst->render();
+        holdDrawing(false);
+        double renderTime = elapsedUs(start);
+
+        DrawCounts after = drawCounts();
+        drawFrameDone();
+
+        if (frame >= WarmupFrames) {
+            updateUs.push_back(updateTime);
+            renderUs.push_back(renderTime);
+            draws.push_back((double)(after.draws - before.draws));
+            drawCalls.push_back((double)(after.drawCalls - before.drawCalls));
+            textureBinds += after.textureBinds - before.textureBinds;
+            pixels += after.pixels - before.pixels;
+        }
+    }
+
+    Stats update = summarise(updateUs);
+    Stats render = summarise(renderUs);
+    Stats drawn = summarise(draws);
+    Stats calls = summarise(drawCalls);
+
+    fprintf(outfile, "%s    {\"instrument\": \"%s\", \"variant\": \"%s\", \"size\": %d, \"shadows\": %s,\n",
+        first ? "" : ",\n", benchCase->name, benchCase->variant, size, shadows ? "true" : "false");
+    fprintf(outfile, "     \"update_us\": {\"p50\": %.2f, \"p99\": %.2f, \"mean\": %.2f},\n", update.p50, update.p99, update.mean);
+    fprintf(outfile, "     \"render_us\": {\"p50\": %.2f, \"p99\": %.2f, \"mean\": %.2f},\n", render.p50, render.p99, render.mean);
+    fprintf(outfile, "     \"bitmaps_drawn\": {\"p50\": %.0f, \"p99\": %.0f},\n", drawn.p50, drawn.p99);
+    fprintf(outfile, "     \"draw_calls\": {\"p50\": %.0f, \"p99\": %.0f},\n", calls.p50, calls.p99);
+    fprintf(outfile, "     \"texture_binds\": %.1f, \"kpixels_filled\": %.1f}",
+        textureBinds / frameCount, pixels / frameCount / 1000);
+
+    fprintf(stderr, "%-14s %-5s %4d shadows %-3s  update p50 %8.2f us  render p50 %8.2f us p99 %8.2f us\n",
+        benchCase->name, benchCase->variant, size, shadows ? "on" : "off", update.p50, render.p50, render.p99);
+
+    delete inst;
+    delete globals.simVars;
+    globals.simVars = NULL;
+
+    if (strlen(globals.error) > 0) {
+        fprintf(stderr, "%s\n", globals.error);
+        globals.error[0] = '\0';
+    }
+}
+
+/// <summary>
+/// Returns true if the instrument is in the -i list (or there isn't one)
+/// </summary>
+bool wanted(const char* name)
+{
+    if (!onlyNames) {
+        return true;
+    }
+
+    const char* start = onlyNames;
+    while (*start) {
+        const char* end = strchr(start, ',');
+        int len = end ? (int)(end - start) : (int)strlen(start);
+        if ((int)strlen(name) == len && strncmp(start, name, len) == 0) {
+            return true;
+        }
+        if (!end) {
+            break;
+        }
+        start = end + 1;
+    }
+
+    return false;
+}
+
+int main(int argc, char* argv[])
+{
+    const char* reportFile = NULL;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "-d") == 0) {
+            globals.directRender = true;
+            continue;
+        }
+
+        if (i + 1 >= argc) {
+            printf("Usage: render-bench [-n frames] [-s sizes] [-i instruments] [-d] [-o report_file]\n");
+            return 1;
+        }
+
+        if (strcmp(argv[i], "-n") == 0) {
+            frameCount = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "-s") == 0) {
+            sizeCount = 0;
+            char* list = argv[++i];
+            for (char* size = strtok(list, ","); size && sizeCount < MaxSizes; size = strtok(NULL, ",")) {
+                sizes[sizeCount++] = atoi(size);
+            }
+        }
+        else if (strcmp(argv[i], "-i") == 0) {
+            onlyNames = argv[++i];
+        }
+        else if (strcmp(argv[i], "-o") == 0) {
+            reportFile = argv[++i];
+        }
+        else {
+            printf("Unknown option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (frameCount <= 0) {
+        printf("Frames must be at least 1\n");
+        return 1;
+    }
+
+    int maxSize = 0;
+    for (int i = 0; i < sizeCount; i++) {
+        if (sizes[i] <= 0) {
+            printf("Sizes must be at least 1\n");
+            return 1;
+        }
+        maxSize = std::max(maxSize, sizes[i]);
+    }
+
+    if (!al_init() || !al_init_font_addon() || !al_init_image_addon()) {
+        printf("Failed to initialise Allegro\n");
+        return 1;
+    }
+
+    // Instruments use their default positions and nothing gets saved
+    globals.SettingsFile = "/dev/null";
+    globals.headless = true;
+    globals.electrics = true;
+    globals.frameSteps = 1;
+    globals.stepFraction = 1;
+
+    // Everything is a memory bitmap without a display
+    al_set_new_bitmap_flags(ALLEGRO_MEMORY_BITMAP);
+    globals.displayWidth = maxSize * 2;
+    globals.displayHeight = maxSize * 2;
+    globals.screen = al_create_bitmap(globals.displayWidth, globals.displayHeight);
+    globals.font = al_create_builtin_font();
+    if (!globals.screen || !globals.font) {
+        printf("Failed to create offscreen bitmap\n");
+        return 1;
+    }
+
+    char packPath[256];
+    strcpy(packPath, globals.BitmapDir);
+    strcat(packPath, PackFile);
+    globals.assetPack = new bitmapPack(packPath);
+    globals.sharedBitmaps = new bitmapCache();
+    globals.spriteAtlas = new atlas();
+
+    FILE* outfile = stdout;
+    if (reportFile && (outfile = fopen(reportFile, "w")) == NULL) {
+        printf("Failed to create %s\n", reportFile);
+        return 1;
+    }
+
+    fprintf(outfile, "{\n  \"frames\": %d,\n  \"warmup_frames\": %d,\n", frameCount, WarmupFrames);
+    fprintf(outfile, "  \"direct\": %s,\n  \"offscreen\": true,\n  \"runs\": [\n", globals.directRender ? "true" : "false");
+
+    bool first = true;
+    for (const Case& benchCase : Cases) {
+        if (!wanted(benchCase.name)) {
+            continue;
+        }
+
+        for (int i = 0; i < sizeCount; i++) {
+            run(outfile, &benchCase, sizes[i], true, first);
+            run(outfile, &benchCase, sizes[i], false, false);
+            first = false;
+        }
+
+        // Free the sheets before the next instrument
+        globals.sharedBitmaps->trim();
+    }
+
+    fprintf(outfile, "\n  ]\n}\n");
+    if (outfile != stdout) {
+        fclose(outfile);
+    }
+
+    delete globals.spriteAtlas;
+    delete globals.sharedBitmaps;
+    delete globals.assetPack;
+    al_destroy_font(globals.font);
+    al_destroy_bitmap(globals.screen);
+    return 0;
+}